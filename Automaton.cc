@@ -4,97 +4,352 @@
  * @brief Management of automate
  * @version 1.0
  * @date 2021-12-19
- * 
+ *
  */
 #include "Automaton.h"
 
+#include <array>
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <tuple>
+
+/* the instrumentation is compiled out unless FA_ENABLE_STATS is defined */
+#ifdef FA_ENABLE_STATS
+#define FA_STATS(statement) statement
+#else
+#define FA_STATS(statement)
+#endif
+
 namespace fa {
   /**
-   * @brief remove a state from the automate and return the iterator to the following state.
-   * 
-   * @param state id of the state
-   * @return std::optional<std::map<int, State>::iterator> (success)
-   * @return std::nullopt (failure)
+   * @brief order of the transitions leaving a state: by letter, then by target.
+   *
+   * @param lhs the first transition
+   * @param rhs the second transition
+   * @return true if lhs is before rhs
    */
-  std::optional<std::map<int, State>::iterator> Automaton::betterRemoveState(int state){
-    std::map<int, State>::iterator position = node.find(state);
-    if (position != node.end()){
-      auto ptr = node.erase(position);
+  static bool isLinkBefore(const Link& lhs, const Link& rhs){
+    return lhs.letter < rhs.letter || (lhs.letter == rhs.letter && lhs.target < rhs.target);
+  }
 
-      for(auto it = transition.begin(); it != transition.end(); ){
-        if(it->first == state || it->second.target == state){
-          it = transition.erase(it);
-        }else{
-          ++it;
-        }
+  /**
+   * @brief the memory of the temporary structures of an algorithm.
+   * The calling thread draws from a monotonic arena released at the end of the call;
+   * the arenas and pools of the other threads draw from the upstream resource, which
+   * must then be thread-safe. With the instrumentation, the allocations made from the
+   * upstream resource are counted.
+   */
+  class Scratch{
+  public:
+    explicit Scratch(std::pmr::memory_resource* resource)
+#ifdef FA_ENABLE_STATS
+    : counting(resource), arena(&counting){
+#else
+    : resource(resource), arena(resource){
+#endif
+    }
+
+    std::pmr::memory_resource* get(){
+      return &arena;
+    }
+
+    std::pmr::memory_resource* upstream(){
+#ifdef FA_ENABLE_STATS
+      return &counting;
+#else
+      return resource;
+#endif
+    }
+
+#ifdef FA_ENABLE_STATS
+    std::size_t allocations() const{
+      return counting.allocations.load(std::memory_order_relaxed);
+    }
+
+    std::size_t bytes() const{
+      return counting.bytes.load(std::memory_order_relaxed);
+    }
+
+  private:
+    /* the workers allocate concurrently, hence the atomic counters */
+    struct Counting : std::pmr::memory_resource{
+      explicit Counting(std::pmr::memory_resource* upstream)
+      : upstream(upstream), allocations(0), bytes(0){
       }
-      return ptr;
+
+      std::pmr::memory_resource* upstream;
+      std::atomic<std::size_t> allocations;
+      std::atomic<std::size_t> bytes;
+
+      void* do_allocate(std::size_t size, std::size_t alignment) override{
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(size, std::memory_order_relaxed);
+        return upstream->allocate(size, alignment);
+      }
+
+      void do_deallocate(void* p, std::size_t size, std::size_t alignment) override{
+        upstream->deallocate(p, size, alignment);
+      }
+
+      bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override{
+        return this == &other;
+      }
+    };
+    Counting counting;
+#else
+  private:
+    std::pmr::memory_resource* resource;
+#endif
+    std::pmr::monotonic_buffer_resource arena;
+  };
+
+#ifdef FA_ENABLE_STATS
+  /**
+   * @brief record a phase of an algorithm when going out of scope.
+   */
+  class PhaseScope{
+  public:
+    PhaseScope(Stats& stats, const char* name, const Scratch& scratch)
+    : stats(stats), name(name), scratch(scratch), start(std::chrono::steady_clock::now()),
+      allocations(scratch.allocations()), bytes(scratch.bytes()){
     }
-    return std::nullopt;
+
+    ~PhaseScope(){
+      stats.phases.push_back({name, std::chrono::steady_clock::now() - start,
+        scratch.allocations() - allocations, scratch.bytes() - bytes});
+    }
+
+  private:
+    Stats& stats;
+    const char* name;
+    const Scratch& scratch;
+    std::chrono::steady_clock::time_point start;
+    std::size_t allocations;
+    std::size_t bytes;
+  };
+
+  /**
+   * @brief keep the largest automaton seen, then give the counters to the callback.
+   *
+   * @param stats the counters
+   * @param states the number of states in flight
+   * @param transitions the number of transitions in flight
+   */
+  static void reportProgress(Stats& stats, std::size_t states, std::size_t transitions){
+    stats.peakStates = std::max(stats.peakStates, states);
+    stats.peakTransitions = std::max(stats.peakTransitions, transitions);
+    if(stats.progress){
+      stats.progress(stats);
+    }
+  }
+#endif
+
+  /**
+   * @brief tell if an automaton of this size, or the time spent, is over the budget.
+   *
+   * @param states the number of states
+   * @param transitions the number of transitions
+   * @return true if the operation must give up
+   */
+  bool Budget::isExceeded(std::size_t states, std::size_t transitions) const{
+    if(states > maxStates || transitions > maxTransitions){
+      return true;
+    }
+    if(cancelled != nullptr && cancelled->load(std::memory_order_relaxed)){
+      return true;
+    }
+    return deadline.has_value() && std::chrono::steady_clock::now() > *deadline;
+  }
+
+  /**
+   * @brief return the index of a state.
+   *
+   * @param state the number of the state
+   * @return index (success)
+   * @return -1 (failure)
+   */
+  int Automaton::getIndex(int state) const{
+    auto position = index->find(state);
+    if(position != index->end()){
+      return position->second;
+    }
+    return -1;
+  }
+
+  /**
+   * @brief check if the index is the one of a removed state.
+   *
+   * @param actualNode the index
+   * @return true (removed)
+   * @return false (in use)
+   */
+  bool Automaton::isRemoved(int actualNode) const{
+    return ids[actualNode] == Removed;
   }
 
   /**
-   * @brief remove a transition from the automate and return the iterator to the following state.
-   * 
+   * @brief add a transition between two indexes, the symbol is not checked.
+   *
    * @param from the index of the origin of the transition
    * @param alpha the letter of the transition
    * @param to the index of the arrival of the transition
-   * @return std::optional<std::multimap<int, Link>::iterator> (success)
-   * @return std::nullopt (failure)
+   * @return true (success)
+   * @return false (the transition already exists)
+   */
+  bool Automaton::addLink(int from, char alpha, int to){
+    std::vector<Link>& links = writeEdges()[from];
+    const Link link = {alpha, to};
+    auto position = std::lower_bound(links.begin(), links.end(), link, isLinkBefore);
+    if(position != links.end() && position->letter == alpha && position->target == to){
+      return false;
+    }
+    links.insert(position, link);
+    transitionCount++;
+    return true;
+  }
+
+  /**
+   * @brief find the transitions of a given letter leaving an index.
+   *
+   * @param from the index of the origin
+   * @param alpha the letter
+   * @return the range of the transitions, sorted by target
+   */
+  std::pair<std::vector<Link>::const_iterator, std::vector<Link>::const_iterator> Automaton::getLinks(int from, char alpha) const{
+    const std::vector<Link>& links = (*edges)[from];
+    return std::equal_range(links.begin(), links.end(), Link{alpha, 0}, [](const Link& lhs, const Link& rhs){
+      return lhs.letter < rhs.letter;
+    });
+  }
+
+  /**
+   * @brief give the transitions for a change, the index of the predecessors becoming outdated.
+   *
+   * @return the transitions of every index, not shared with another automate
+   */
+  std::vector<std::vector<Link>>& Automaton::writeEdges(){
+    predecessorIndex.reset();
+    return edges.write();
+  }
+
+  /**
+   * @brief replace the transitions, the index of the predecessors becoming outdated.
+   *
+   * @param table the transitions of every index, sorted by letter then target
+   */
+  void Automaton::setEdges(std::vector<std::vector<Link>>&& table){
+    predecessorIndex.reset();
+    edges = Shared<std::vector<std::vector<Link>>>(std::move(table));
+  }
+
+  /**
+   * @brief give the transitions arriving at every index, indexed at the first call.
+   * Several threads can call it at the same time, the first index stored is kept.
+   *
+   * @return the predecessors
    */
-  std::optional<std::multimap<int, Link>::iterator> Automaton::betterRemoveTransition(int from, char alpha, int to){
-    auto position = this->transition.equal_range(from);
-    for(auto &it = position.first; it != position.second; ){
-      if(it->second.letter == alpha && it->second.target == to){
-        return transition.erase(it);
+  const Automaton::Predecessors& Automaton::getPredecessors() const{
+    std::shared_ptr<const Predecessors> current = std::atomic_load(&predecessorIndex);
+    if(current){
+      return *current;
+    }
+
+    /* count the links arriving at every index, then place them */
+    const std::size_t n = edges->size();
+    auto built = std::make_shared<Predecessors>();
+    built->begin.assign(n + 1, 0);
+    for(auto const &links : *edges){
+      for(auto const &link : links){
+        built->begin[link.target + 1]++;
       }
-      ++it;
     }
-    return std::nullopt;
+    for(std::size_t i = 0; i < n; i++){
+      built->begin[i + 1] += built->begin[i];
+    }
+    built->links.resize(built->begin[n]);
+    std::vector<std::size_t> position(built->begin.begin(), built->begin.end() - 1);
+    for(std::size_t from = 0; from < n; from++){
+      for(auto const &link : (*edges)[from]){
+        built->links[position[link.target]++] = {link.letter, (int)from};
+      }
+    }
+    for(std::size_t i = 0; i < n; i++){
+      std::sort(built->links.begin() + built->begin[i], built->links.begin() + built->begin[i + 1], isLinkBefore);
+    }
+
+    /* another thread may have stored its index first, which stays the one in use */
+    std::shared_ptr<const Predecessors> stored = built;
+    if(!std::atomic_compare_exchange_strong(&predecessorIndex, &current, stored)){
+      return *current;
+    }
+    return *built;
   }
 
   /**
-   * @brief find and return if there are transition by providing the origin and the letter only.
-   * 
-   * @param from id of the origin state
-   * @param alpha letter
-   * @return std::optional<std::set<int>> (success)
-   * @return std::nullopt (failure)
+   * @brief remove every state that is not kept, with their transitions, then compact the automate.
+   *
+   * @param keptNodes for every index, true if the state is kept
    */
-  std::optional<std::set<int>> Automaton::transitionBeginWith(int from, char alpha) const{
-    std::set<int> rtn;
-    auto position = this->transition.equal_range(from);
-    for(auto i = position.first; i != position.second; i++){
-      if(i->first == from && i->second.letter == alpha){
-        rtn.insert(i->second.target);
+  void Automaton::removeStates(const std::vector<bool>& keptNodes){
+    bool removed = false;
+    for(std::size_t i = 0; i < ids.size(); i++){
+      if(!keptNodes[i] && !isRemoved(i)){
+        index.write().erase(ids[i]);
+        ids[i] = Removed;
+        removed = true;
       }
     }
-    if(rtn.empty()){
-      return std::nullopt;
+
+    /* nothing to change in the transitions, which may be shared with other automata */
+    if(!removed){
+      compact();
+      return;
     }
-    return rtn;
+
+    auto &table = writeEdges();
+    transitionCount = 0;
+    for(std::size_t i = 0; i < ids.size(); i++){
+      if(isRemoved(i)){
+        table[i].clear();
+        continue;
+      }
+      auto &links = table[i];
+      links.erase(std::remove_if(links.begin(), links.end(), [this](const Link& link){
+        return isRemoved(link.target);
+      }), links.end());
+      transitionCount += links.size();
+    }
+
+    compact();
   }
 
   /**
    * @brief research in depth of a final state in the automate.
-   * 
-   * @param actualNode the current state
+   *
+   * @param actualNode the index of the current state
    * @param knownNodes the already visited states
    * @return true (success)
    * @return false (failure)
    */
-  bool Automaton::researchFinalStateInDepth(int actualNode, std::set<int>& knownNodes) const{
-    knownNodes.insert(actualNode);
-    if(this->isStateFinal(actualNode)){
-      return true;
-    }
-    
-    for(auto const &it: this->transition){
-      if(it.first == actualNode){
-        if(knownNodes.find(it.second.target) == knownNodes.end()){ //knownNodes.contains(it.second.target)
-          if(this->researchFinalStateInDepth(it.second.target, knownNodes)){
-            return true;
-          }
+  bool Automaton::researchFinalStateInDepth(int actualNode, std::vector<bool>& knownNodes) const{
+    std::vector<int> pending = {actualNode};
+    knownNodes[actualNode] = true;
+    while(!pending.empty()){
+      int current = pending.back();
+      pending.pop_back();
+      if(states[current].final){
+        return true;
+      }
+      for(auto const &link : (*edges)[current]){
+        if(!knownNodes[link.target]){
+          knownNodes[link.target] = true;
+          pending.push_back(link.target);
         }
       }
     }
@@ -103,16 +358,20 @@ namespace fa {
 
   /**
    * @brief list all the states reachable using a research by child.
-   * 
-   * @param actualNode the current state
+   *
+   * @param actualNode the index of the current state
    * @param knownNodes the already visited states
    */
-  void Automaton::researchInDepth(int actualNode, std::set<int>& knownNodes) const{
-    knownNodes.insert(actualNode);
-    for(auto const &it: this->transition){
-      if(it.first == actualNode){
-        if(knownNodes.find(it.second.target) == knownNodes.end()){ //knownNodes.contains(it.second.target)
-          this->researchInDepth(it.second.target, knownNodes);
+  void Automaton::researchInDepth(int actualNode, std::vector<bool>& knownNodes) const{
+    std::vector<int> pending = {actualNode};
+    knownNodes[actualNode] = true;
+    while(!pending.empty()){
+      int current = pending.back();
+      pending.pop_back();
+      for(auto const &link : (*edges)[current]){
+        if(!knownNodes[link.target]){
+          knownNodes[link.target] = true;
+          pending.push_back(link.target);
         }
       }
     }
@@ -120,16 +379,48 @@ namespace fa {
 
   /**
    * @brief list all the states reachable using a research by parent.
-   * 
-   * @param actualNode the current state
-   * @param knowNodes the already visited states
+   *
+   * @param actualNode the index of the current state
+   * @param knownNodes the already visited states
+   */
+  void Automaton::researchInSurface(int actualNode, std::vector<bool>& knownNodes) const{
+    const Predecessors& predecessors = getPredecessors();
+    std::vector<int> pending = {actualNode};
+    knownNodes[actualNode] = true;
+    while(!pending.empty()){
+      int current = pending.back();
+      pending.pop_back();
+      for(std::size_t p = predecessors.begin[current]; p < predecessors.begin[current + 1]; p++){
+        int from = predecessors.links[p].target;
+        if(!knownNodes[from]){
+          knownNodes[from] = true;
+          pending.push_back(from);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief list all the states reachable from a state with epsilon transitions only.
+   * The states already known are not added to the closure.
+   *
+   * @param actualNode the index of the current state
+   * @param knownNodes the already visited states
+   * @param closure the indexes of the states found, in the order of discovery
    */
-  void Automaton::researchInSurface(int actualNode, std::set<int>& knowNodes) const{
-    knowNodes.insert(actualNode);
-    for(auto const &it: this->transition){
-      if(it.second.target == actualNode){
-        if(knowNodes.find(it.first) == knowNodes.end()){
-          this->researchInSurface(it.first, knowNodes);
+  void Automaton::researchEpsilonClosure(int actualNode, std::pmr::vector<bool>& knownNodes, std::pmr::vector<int>& closure) const{
+    if(knownNodes[actualNode]){
+      return;
+    }
+    std::size_t begin = closure.size();
+    knownNodes[actualNode] = true;
+    closure.push_back(actualNode);
+    for(std::size_t i = begin; i < closure.size(); i++){
+      auto position = getLinks(closure[i], fa::Epsilon);
+      for(auto it = position.first; it != position.second; it++){
+        if(!knownNodes[it->target]){
+          knownNodes[it->target] = true;
+          closure.push_back(it->target);
         }
       }
     }
@@ -137,30 +428,28 @@ namespace fa {
 
   /**
    * @brief find the intersection of two alphabets.
-   * 
+   *
    * @param lhs first alphabet
    * @param rhs second alphabet
-   * @return std::set<char> 
+   * @return std::set<char>
    */
   std::set<char> Automaton::createAlphabetProduct(const std::set<char>& lhs, const std::set<char>& rhs){
     std::set<char> product;
-    for(auto const &it_lhs : lhs){
-      for(auto const &it_rhs : rhs){
-        if(it_lhs == it_rhs){
-          product.insert(it_lhs);
-        }
-      }
-    }
+    std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::inserter(product, product.end()));
     return product;
   }
 
   /**
-   * @brief return the lowest number available for a new state.
-   * 
+   * @brief return a number available for a new state, greater than every number in use
+   * unless the greatest number is taken.
+   *
    * @return number (success)
-   * @return -1 (failure) 
+   * @return -1 (failure)
    */
   int Automaton::getNumberForNewNode() const{
+    if(!hasState(nextNumber)){
+      return nextNumber;
+    }
     for(int number = 0; number < (int)this->countStates()+1; number++){
       if(!this->hasState(number)){
         return number;
@@ -168,112 +457,81 @@ namespace fa {
     }
     return -1;
   }
-  
+
   /**
-   * @brief return all the nodes that are found after itering through the automate followinf the word
+   * @brief return all the nodes that are found after itering through the automate following the word.
    * The set is empty if there was no route available.
-   * 
-   * @param actualNode the current node
+   *
+   * @param actualNodes the indexes of the current nodes
    * @param word the word to iterate through
-   * @return std::set<int> 
+   * @return StateSet the indexes of the last nodes
    */
-  std::set<int> Automaton::getLastNodesOfTheWord(int actualNode, const std::string& word) const{
-    std::set<int> rtn;
-
-    if(this->hasEpsilonTransition()){ //if the Automaton has an Epsilon transition inside
-      auto position = this->transition.equal_range(actualNode);
-      for(auto &it = position.first; it != position.second; it++){
-        if(it->second.letter == fa::Epsilon && it->first != it->second.target){
-          rtn.merge(this->getLastNodesOfTheWord(it->second.target, word));
-        }
+  StateSet Automaton::getLastNodesOfTheWord(const StateSet& actualNodes, const std::string& word) const{
+    /* the nodes of every step are drawn from an arena, on the stack for small automata */
+    std::array<std::byte, 4096> buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+    const bool epsilon = this->hasEpsilonTransition();
+    std::pmr::vector<bool> knownNodes(states.size(), false, &arena);
+    std::pmr::vector<int> current(&arena), next(&arena);
+
+    /* add a node, and the nodes reachable with epsilon transitions, to the nodes */
+    auto add = [&](int node, std::pmr::vector<int>& nodes){
+      if(epsilon){
+        this->researchEpsilonClosure(node, knownNodes, nodes);
+      }else if(!knownNodes[node]){
+        knownNodes[node] = true;
+        nodes.push_back(node);
       }
-    }
+    };
 
-    if(word.begin() == word.end()){
-      rtn.insert(actualNode);
-      return rtn;
+    for(int node : actualNodes){
+      add(node, current);
     }
-
-    auto targettedNodes = this->transitionBeginWith(actualNode, *word.begin());
-    if(targettedNodes.has_value()){
-      for(auto const &it: targettedNodes.value()){
-        rtn.merge(this->getLastNodesOfTheWord(it, word.substr(1)));
+    for(char letter : word){
+      for(int node : current){
+        knownNodes[node] = false;
       }
-    }
-    return rtn;
-  }
-
-  /**
-   * @brief remove the epsilon transitions from an automaton
-   * 
-   * @param actualNode the current node
-   * @param knowNodes the already visited states
-   */
-  void Automaton::removeEpsilonTransition(int actualNode, std::set<int>& knownNodes){
-    std::set<int> reachable;
-
-    if(knownNodes.find(actualNode) == knownNodes.end()){
-      knownNodes.insert(actualNode);
-
-      auto position = transition.equal_range(actualNode);
-      for(auto it = position.first; it != position.second; ){
-        /* call back the function on every nodes visitable from the actual node */
-        this->removeEpsilonTransition(it->second.target, knownNodes);
-        
-        /* look for an epsilon transition */
-        if(it->second.letter == fa::Epsilon){
-
-          /* find every nodes that are the target of the epsilon transition(s) */
-          if(it->first != it->second.target){
-            reachable.merge(this->getLastNodesOfTheWord(it->second.target, ""));
-          }
-
-          /* check if the target is final */
-          if(this->isStateFinal(it->second.target)){
-            this->setStateFinal(it->first);
-          }
-
-          /* remove the epsilon transition */
-          it = this->betterRemoveTransition(it->first, it->second.letter, it->second.target).value();
-        }else{
-          it++;
+      for(int node : current){
+        auto position = getLinks(node, letter);
+        for(auto it = position.first; it != position.second; it++){
+          add(it->target, next);
         }
       }
-
-      /* update the transitions to the nodes targetted by the epsilon transition(s) */
-      for(auto const &node : reachable){
-        auto position = this->transition.equal_range(node);
-        for(auto &it = position.first; it != position.second; it++){
-          if(it->second.letter != fa::Epsilon){
-            this->addTransition(actualNode, it->second.letter, it->second.target);
-          }
-        }
+      current.swap(next);
+      next.clear();
+      if(current.empty()){
+        break;
       }
-
     }
+    std::sort(current.begin(), current.end());
+    StateSet rtn;
+    rtn.assign(current.data(), current.data() + current.size());
+    return rtn;
   }
 
+
   /**
    * @brief Construct a new Automaton:: Automaton object
-   * 
+   *
    */
-  Automaton::Automaton(){
+  Automaton::Automaton()
+  : transitionCount(0), nextNumber(0){
   }
 
   /**
    * @brief test if the automate is valid.
    * (ie: has at least one state and at least one symbol)
-   * 
+   *
    * @return true (success)
    * @return false (failure)
    */
   bool Automaton::isValid() const {
-    return (!alphabet.empty() && !node.empty());
+    return (!alphabet.empty() && !index->empty());
   }
 
   /**
    * @brief add a symbol to the alphabet.
-   * 
+   *
    * @param symbol the letter
    * @return true (success)
    * @return false (failure)
@@ -291,7 +549,7 @@ namespace fa {
 
   /**
    * @brief remove a symbol to the alphabet.
-   * 
+   *
    * @param symbol the letter
    * @return true (success)
    * @return false (failure)
@@ -301,12 +559,11 @@ namespace fa {
     if (position != alphabet.end()){
       alphabet.erase(position);
 
-      for(auto it = transition.begin(); it != transition.end(); ){
-        if(it->second.letter == symbol){
-          it = transition.erase(it);
-        }else{
-          ++it;
-        }
+      auto &table = writeEdges();
+      for(std::size_t i = 0; i < table.size(); i++){
+        auto links = getLinks(i, symbol);
+        transitionCount -= links.second - links.first;
+        table[i].erase(links.first, links.second);
       }
       return true;
     }
@@ -315,7 +572,7 @@ namespace fa {
 
   /**
    * @brief check if the alphabet contains the given symbol.
-   * 
+   *
    * @param symbol the letter
    * @return true (success)
    * @return false (failure)
@@ -326,8 +583,8 @@ namespace fa {
 
   /**
    * @brief returns the number of symbol in the alphabet.
-   * 
-   * @return std::size_t 
+   *
+   * @return std::size_t
    */
   std::size_t Automaton::countSymbols() const{
     return alphabet.size();
@@ -335,14 +592,22 @@ namespace fa {
 
   /**
    * @brief add a state to the automate.
-   * 
-   * @param state the index of the state
+   *
+   * @param state the number of the state
    * @return true (success)
    * @return false (failure)
    */
   bool Automaton::addState(int state){
     if(state >= 0){
-      auto rtn = node.insert({state,{false, false}});
+      auto rtn = index.write().insert({state, (int)ids.size()});
+      if(rtn.second){
+        ids.push_back(state);
+        states.push_back({false, false});
+        writeEdges().emplace_back();
+        if(state >= nextNumber){
+          nextNumber = state == INT_MAX ? INT_MAX : state + 1;
+        }
+      }
       return rtn.second;
     }
     return false;
@@ -350,95 +615,187 @@ namespace fa {
 
   /**
    * @brief remove a state of the automate.
-   * 
-   * @param state the index of the state
-   * @return true 
-   * @return false 
+   * The index of the state is left unused until the automate is compacted.
+   *
+   * @param state the number of the state
+   * @return true
+   * @return false
    */
   bool Automaton::removeState(int state){
-    return betterRemoveState(state).has_value();
+    int actualNode = getIndex(state);
+    if(actualNode < 0){
+      return false;
+    }
+
+    auto &table = writeEdges();
+    transitionCount -= table[actualNode].size();
+    table[actualNode].clear();
+    for(auto &links : table){
+      auto end = std::remove_if(links.begin(), links.end(), [actualNode](const Link& link){
+        return link.target == actualNode;
+      });
+      transitionCount -= links.end() - end;
+      links.erase(end, links.end());
+    }
+
+    index.write().erase(state);
+    ids[actualNode] = Removed;
+    states[actualNode] = {false, false};
+    return true;
   }
 
   /**
    * @brief check if the automate contains the given state.
-   * 
-   * @param state the index of the state
+   *
+   * @param state the number of the state
    * @return true (success)
    * @return false (failure)
    */
   bool Automaton::hasState(int state) const{
-    return node.find(state) != node.end();
+    return index->find(state) != index->end();
   }
 
   /**
    * @brief returns the number of states in the automate.
-   * 
-   * @return std::size_t 
+   *
+   * @return std::size_t
    */
   std::size_t Automaton::countStates() const{
-    return node.size();
+    return index->size();
+  }
+
+  /**
+   * @brief give the indexes 0..n-1 to the states in use, keeping their order.
+   *
+   */
+  void Automaton::compact(){
+    if(ids.size() == index->size()){
+      return;
+    }
+
+    auto &table = writeEdges();
+    auto &numbers = index.write();
+    std::vector<int> renumber(ids.size(), Removed);
+    std::size_t n = 0;
+    for(std::size_t i = 0; i < ids.size(); i++){
+      if(!isRemoved(i)){
+        renumber[i] = n;
+        ids[n] = ids[i];
+        states[n] = states[i];
+        table[n].swap(table[i]);
+        numbers[ids[n]] = n;
+        n++;
+      }
+    }
+    ids.resize(n);
+    states.resize(n);
+    table.resize(n);
+
+    /* the renumbering keeps the order, so the transitions stay sorted */
+    for(auto &links : table){
+      for(auto &link : links){
+        link.target = renumber[link.target];
+      }
+    }
+  }
+
+  /**
+   * @brief copy the transitions leaving every state, the removed states being skipped and the
+   * others renumbered 0..n-1 in the order of their indexes.
+   *
+   * @return Successors
+   */
+  Successors Automaton::getSuccessors() const{
+    std::vector<int> renumber(ids.size(), Removed);
+    std::size_t n = 0;
+    for(std::size_t i = 0; i < ids.size(); i++){
+      if(!isRemoved(i)){
+        renumber[i] = n++;
+      }
+    }
+
+    Successors successors;
+    successors.begin.reserve(n + 1);
+    successors.initials.reserve(n);
+    successors.finals.reserve(n);
+    successors.letters.reserve(transitionCount);
+    successors.targets.reserve(transitionCount);
+    for(std::size_t i = 0; i < ids.size(); i++){
+      if(isRemoved(i)){
+        continue;
+      }
+      successors.begin.push_back(successors.letters.size());
+      for(auto const &link : (*edges)[i]){
+        successors.letters.push_back(link.letter);
+        successors.targets.push_back(renumber[link.target]);
+      }
+      successors.initials.push_back(states[i].initial);
+      successors.finals.push_back(states[i].final);
+    }
+    successors.begin.push_back(successors.letters.size());
+    return successors;
   }
 
   /**
    * @brief set the state as initial.
-   * 
-   * @param state the index of the state
+   *
+   * @param state the number of the state
    */
   void Automaton::setStateInitial(int state){
-    auto position = node.find(state);
-    if(position != node.end()){
-      position->second.initial=true;
+    int position = getIndex(state);
+    if(position >= 0){
+      states[position].initial=true;
     }
   }
 
   /**
    * @brief check if the state is initial.
-   * 
-   * @param state the index of the state
+   *
+   * @param state the number of the state
    * @return true (success)
    * @return false (failure)
    */
   bool Automaton::isStateInitial(int state) const{
-    auto position = node.find(state);
-    if(position != node.end()){
-      return position->second.initial;
+    int position = getIndex(state);
+    if(position >= 0){
+      return states[position].initial;
     }
     return false;
   }
 
   /**
    * @brief set the state as final.
-   * 
-   * @param state the index of the state
+   *
+   * @param state the number of the state
    */
   void Automaton::setStateFinal(int state){
-    auto position = node.find(state);
-    if(position != node.end()){
-      position->second.final=true;
-    }    
+    int position = getIndex(state);
+    if(position >= 0){
+      states[position].final=true;
+    }
   }
 
   /**
    * @brief check if the state is final.
-   * 
-   * @param state the index of the state
+   *
+   * @param state the number of the state
    * @return true (success)
    * @return false (failure)
    */
   bool Automaton::isStateFinal(int state) const{
-    auto position = node.find(state);
-    if(position != node.end()){
-      return position->second.final;
+    int position = getIndex(state);
+    if(position >= 0){
+      return states[position].final;
     }
     return false;
   }
 
   /**
    * @brief add a transition to the automate.
-   * 
-   * @param from the index of the origin of the transition
+   *
+   * @param from the number of the origin of the transition
    * @param alpha the letter of the transition
-   * @param to the index of the arrival of the transition
+   * @param to the number of the arrival of the transition
    * @return true (success)
    * @return false (failure)
    */
@@ -446,73 +803,114 @@ namespace fa {
     if(from<0 || to<0 || (!isgraph(alpha) && alpha!=fa::Epsilon)){
       return false;
     }
-    if(!hasState(from) || !hasState(to)){
+    int index_from = getIndex(from);
+    int index_to = getIndex(to);
+    if(index_from < 0 || index_to < 0){
       return false;
     }
     if(!hasSymbol(alpha) && alpha!=fa::Epsilon){
       return false;
     }
 
-    if(hasTransition(from, alpha, to)){
-      return false;
-    }
-
-    transition.insert({from,{alpha, to}});
-    return true;
+    return addLink(index_from, alpha, index_to);
   }
 
   /**
    * @brief remove a transition of the automate.
-   * 
-   * @param from the index of the origin of the transition
+   *
+   * @param from the number of the origin of the transition
    * @param alpha the letter of the transition
-   * @param to the index of the arrival of the transition
+   * @param to the number of the arrival of the transition
    * @return true (success)
    * @return false (failure)
    */
   bool Automaton::removeTransition(int from, char alpha, int to){
-    return betterRemoveTransition(from, alpha, to).has_value();
+    int index_from = getIndex(from);
+    int index_to = getIndex(to);
+    if(index_from < 0 || index_to < 0){
+      return false;
+    }
+
+    std::vector<Link>& links = writeEdges()[index_from];
+    const Link link = {alpha, index_to};
+    auto position = std::lower_bound(links.begin(), links.end(), link, isLinkBefore);
+    if(position != links.end() && position->letter == alpha && position->target == index_to){
+      links.erase(position);
+      transitionCount--;
+      return true;
+    }
+    return false;
   }
 
   /**
    * @brief check if the automate has the given transition.
-   * 
-   * @param from the index of the origin of the transition
+   *
+   * @param from the number of the origin of the transition
    * @param alpha the letter of the transition
-   * @param to the index of the arrival of the transition
+   * @param to the number of the arrival of the transition
    * @return true (success)
    * @return false (failure)
    */
   bool Automaton::hasTransition(int from, char alpha, int to) const{
-    auto position = this->transition.equal_range(from);
-    for(auto &it = position.first; it != position.second; it++){
-      if(it->first == from && it->second.letter == alpha && it->second.target == to){
-        return true;
-      }
+    int index_from = getIndex(from);
+    int index_to = getIndex(to);
+    if(index_from < 0 || index_to < 0){
+      return false;
     }
-    return false;
+    return std::binary_search((*edges)[index_from].begin(), (*edges)[index_from].end(), Link{alpha, index_to}, isLinkBefore);
+  }
+
+  /**
+   * @brief find the states having a transition with the letter to the state.
+   *
+   * @param state the number of the arrival
+   * @param alpha the letter
+   * @return StateSet the numbers of the origins, empty if the state does not exist
+   */
+  StateSet Automaton::predecessors(int state, char alpha) const{
+    StateSet result;
+    int actualNode = getIndex(state);
+    if(actualNode < 0){
+      return result;
+    }
+    const Predecessors& predecessors = getPredecessors();
+    auto begin = predecessors.links.begin() + predecessors.begin[actualNode];
+    auto end = predecessors.links.begin() + predecessors.begin[actualNode + 1];
+    auto links = std::equal_range(begin, end, Link{alpha, 0}, [](const Link& lhs, const Link& rhs){
+      return lhs.letter < rhs.letter;
+    });
+    for(auto it = links.first; it != links.second; ++it){
+      result.insert(ids[it->target]);
+    }
+    return result;
   }
-  
+
   /**
    * @brief returns the number of transition in the automate
-   * 
-   * @return std::size_t 
+   *
+   * @return std::size_t
    */
   std::size_t Automaton::countTransitions() const{
-    return transition.size();
+    return transitionCount;
   }
 
   /**
    * @brief print the automate.
-   * 
+   *
    * @param os the stream to input the automate
    */
   void Automaton::prettyPrint(std::ostream& os) const{
+    /* print the states by number, whatever their index */
+    std::map<int, int> sorted;
+    for(auto const &it : *index){
+      sorted.insert(it);
+    }
+
     /*  print of initial state(s) */
     os << "Initial states:" << std::endl;
     bool init=false;
-    for(auto const &it : node){
-      if(isStateInitial(it.first)){
+    for(auto const &it : sorted){
+      if(states[it.second].initial){
         if(!init){
           os << "\t" << it.first;
           init=true;
@@ -527,8 +925,8 @@ namespace fa {
     /*  print of final state(s) */
     os << "Final states:" << std::endl;
     bool final=false;
-    for(auto const &it : node){
-      if(isStateFinal(it.first)){
+    for(auto const &it : sorted){
+      if(states[it.second].final){
         if(!final){
           os << "\t" << it.first;
           final=true;
@@ -542,42 +940,180 @@ namespace fa {
 
     /*  print of transition(s) */
     os << "Transition:" << std::endl;
-    std::set<int> nodeUsed;
     bool first = true;
-    for(auto const &transi : transition){
-      std::set<int>::iterator it = nodeUsed.find(transi.first);
-      if(it == nodeUsed.end()){
-        nodeUsed.insert(transi.first);
-        if(!first){
-          os << std::endl;
+    for(auto const &it : sorted){
+      if((*edges)[it.second].empty()){
+        continue;
+      }
+      if(!first){
+        os << std::endl;
+      }
+      os << "\tFor state " << it.first << ":" << std::endl;
+
+      for(auto const &c : (*edges)[it.second]){
+        os << "\t\t" << "--" << c.letter << "--> " << ids[c.target] << std::endl;
+      }
+      first = false;
+    }
+  }
+
+  /**
+   * @brief write a letter as a C++ character literal, escaped if it is not printable.
+   *
+   * @param os the stream
+   * @param letter the letter
+   */
+  static void writeLetter(std::ostream& os, char letter){
+    unsigned char code = letter;
+    if(letter == '\'' || letter == '\\'){
+      os << "'\\" << letter << "'";
+    }else if(code >= 0x20 && code < 0x7F){
+      os << "'" << letter << "'";
+    }else{
+      static const char digits[] = "0123456789abcdef";
+      os << "'\\x" << digits[code >> 4] << digits[code & 0xF] << "'";
+    }
+  }
+
+  /**
+   * @brief write a standalone C++ source of a function telling if a word is accepted by the
+   * deterministic automate. Only the live states reachable from the initial state are written,
+   * numbered in breadth-first order, and every other transition rejects at once.
+   *
+   * @param os the stream
+   * @param function the name of the function
+   * @param style a label per state with gotos, or a switch in a loop over the letters
+   */
+  void Automaton::generateSource(std::ostream& os, const std::string& function, SourceStyle style) const{
+    assert(isValid());
+    assert(isDeterministic());
+
+    /* the live states, from which a final state is reachable */
+    std::vector<bool> live(states.size(), false);
+    for(std::size_t i = 0; i < states.size(); i++){
+      if(states[i].final && !isRemoved(i) && !live[i]){
+        researchInSurface(i, live);
+      }
+    }
+
+    /* the live states reachable from the initial state, numbered in breadth-first order */
+    std::vector<int> order;
+    std::vector<int> number(states.size(), -1);
+    for(std::size_t i = 0; i < states.size(); i++){
+      if(states[i].initial && live[i]){
+        number[i] = 0;
+        order.push_back(i);
+      }
+    }
+    for(std::size_t n = 0; n < order.size(); n++){
+      for(auto const &link : (*edges)[order[n]]){
+        if(live[link.target] && number[link.target] < 0){
+          number[link.target] = order.size();
+          order.push_back(link.target);
         }
-        os << "\tFor state " << transi.first << ":" << std::endl;
+      }
+    }
 
-        auto letter = this->transition.equal_range(transi.first);
-        for(auto c = letter.first; c != letter.second; c++){
-          os << "\t\t" << "--" << c->second.letter << "--> " << c->second.target << std::endl;
+    /* write the cases of the letters leading to live states, grouped by target */
+    auto writeCases = [&](int from, const std::string& indent, const std::string& jump, const std::string& after){
+      auto const &links = (*edges)[from];
+      std::vector<bool> written(links.size(), false);
+      for(std::size_t i = 0; i < links.size(); i++){
+        int target = links[i].target;
+        if(written[i] || !live[target]){
+          continue;
         }
-        first = false;
+        for(std::size_t j = i; j < links.size(); j++){
+          if(links[j].target == target){
+            written[j] = true;
+            os << indent << "case ";
+            writeLetter(os, links[j].letter);
+            os << ":\n";
+          }
+        }
+        os << indent << "  " << jump << number[target] << ";" << after << "\n";
+      }
+      os << indent << "default:\n";
+      os << indent << "  return false;\n";
+    };
+
+    os << "// Generated from a deterministic automaton of " << order.size() << " live state(s), do not edit\n";
+    os << "#include <string_view>\n";
+    os << "\n";
+    os << "bool " << function << "(std::string_view word){\n";
+    if(order.empty()){
+      os << "  (void) word;\n";
+      os << "  return false;\n";
+      os << "}\n";
+      return;
+    }
+
+    if(style == SourceStyle::Goto){
+      os << "  const char* it = word.data();\n";
+      os << "  const char* end = it + word.size();\n";
+      os << "  goto s0;\n";
+      for(std::size_t n = 0; n < order.size(); n++){
+        int i = order[n];
+        os << "\n";
+        os << "s" << n << ":  // state " << ids[i] << "\n";
+        bool leaving = std::any_of((*edges)[i].begin(), (*edges)[i].end(), [&](const Link& link){
+          return live[link.target];
+        });
+        if(!leaving){
+          os << "  return it == end;\n";
+          continue;
+        }
+        os << "  if(it == end){\n";
+        os << "    return " << (states[i].final ? "true" : "false") << ";\n";
+        os << "  }\n";
+        os << "  switch(*it++){\n";
+        writeCases(i, "    ", "goto s", "");
+        os << "  }\n";
       }
+    }else{
+      os << "  int state = 0;\n";
+      os << "  for(char letter : word){\n";
+      os << "    switch(state){\n";
+      for(std::size_t n = 0; n < order.size(); n++){
+        os << "      case " << n << ":  // state " << ids[order[n]] << "\n";
+        os << "        switch(letter){\n";
+        writeCases(order[n], "          ", "state = ", " break;");
+        os << "        }\n";
+        os << "        break;\n";
+      }
+      os << "    }\n";
+      os << "  }\n";
+      os << "  switch(state){\n";
+      for(std::size_t n = 0; n < order.size(); n++){
+        if(states[order[n]].final){
+          os << "    case " << n << ":\n";
+        }
+      }
+      os << "      return true;\n";
+      os << "    default:\n";
+      os << "      return false;\n";
+      os << "  }\n";
     }
+    os << "}\n";
   }
 
   // TODO void Automaton::dotPrint(std::ostream& os) const{}
 
   /**
    * @brief check if there are any transition with an epsilon.
-   * 
+   *
    * @return true (success)
    * @return false (failure)
    */
   bool Automaton::hasEpsilonTransition() const{
     assert(isValid());
 
-    for(auto it = transition.begin(); it != transition.end(); it++){
-      if(it->second.letter == fa::Epsilon){
+    /* epsilon is the lowest letter, so it comes first in the sorted transitions */
+    for(auto const &links : *edges){
+      if(!links.empty() && links.front().letter == fa::Epsilon){
         return true;
       }
-    }    
+    }
 
     return false;
   }
@@ -585,13 +1121,13 @@ namespace fa {
   /**
    * @brief check if the automate is deterministic.
    * (ie: every state has a set composed of unique transition for a given symbol)
-   * 
+   *
    * @return true (success)
    * @return false (failure)
    */
   bool Automaton::isDeterministic() const{
     assert(isValid());
-    
+
     /* if there are Epsilon transition */
     if(this->hasEpsilonTransition()){
       return false;
@@ -599,8 +1135,8 @@ namespace fa {
 
     /* if there are multiple Initial state */
     bool oneInitial = false;
-    for(auto const &it : node){
-      if(this->isStateInitial(it.first)){
+    for(std::size_t i = 0; i < states.size(); i++){
+      if(states[i].initial){
         if(!oneInitial){
           oneInitial = true;
         }else{
@@ -613,10 +1149,11 @@ namespace fa {
     }
 
     /* if there are multiple transition with the same origin and letter */
-    for(auto const &it : transition){
-      auto rtn = this->transitionBeginWith(it.first, it.second.letter);
-      if(rtn.value().size() > 1){
-        return false;
+    for(auto const &links : *edges){
+      for(std::size_t i = 1; i < links.size(); i++){
+        if(links[i].letter == links[i-1].letter){
+          return false;
+        }
       }
     }
 
@@ -626,192 +1163,417 @@ namespace fa {
   /**
    * @brief check if the automate is complete.
    * (ie: every state has at least one transition of every symbol in the alphabet)
-   * 
+   *
    * @return true (success)
    * @return false (failure)
    */
   bool Automaton::isComplete() const{
     assert(isValid());
 
-    /* store everytime we find a new pair of 'origin, letter' */
-    std::set<std::pair<int, char>> complete;
-    for(auto const &it : transition){
-      complete.insert(std::make_pair(it.first, it.second.letter));
+    /* count the different letters leaving every state */
+    for(std::size_t i = 0; i < edges->size(); i++){
+      if(isRemoved(i)){
+        continue;
+      }
+      std::size_t letters = 0;
+      auto const &links = (*edges)[i];
+      for(std::size_t j = 0; j < links.size(); j++){
+        if(links[j].letter != fa::Epsilon && (j == 0 || links[j].letter != links[j-1].letter)){
+          letters++;
+        }
+      }
+      if(letters != alphabet.size()){
+        return false;
+      }
     }
-
-    /* test if we have every possibility of 'origin, letter' */
-    return complete.size() == node.size()*alphabet.size();
+    return true;
   }
 
   /**
    * @brief create a complete automate from a given automate
-   * 
+   *
    * @param automaton the automate
-   * @return Automaton 
+   * @return Automaton
    */
   Automaton Automaton::createComplete(const Automaton& automaton){
-    assert(automaton.isValid());
+    fa::Automaton complete = automaton;
+    complete.complete();
+    return complete;
+  }
 
-    if(automaton.isComplete()){
-      return automaton;
+  /**
+   * @brief create a complete automate, reusing the given automate
+   *
+   * @param automaton the automate
+   * @return Automaton
+   */
+  Automaton Automaton::createComplete(Automaton&& automaton){
+    automaton.complete();
+    return std::move(automaton);
+  }
+
+  /**
+   * @brief make the automate complete, adding a sink state if needed
+   *
+   */
+  void Automaton::complete(){
+    assert(isValid());
+
+    if(isComplete()){
+      return;
     }
 
-    /* create a new automaton and add a sink state */
-    fa::Automaton new_automaton = automaton;
-    bool sink_used = false;
-    int sink = new_automaton.getNumberForNewNode();
-    new_automaton.addState(sink);
+    compact();
 
     /*
-     * iterate throught the nodes and create a transition
-     * with the letter missing to the sink state          
+     * the states from which a final state is reachable, the added transitions
+     * never reach a final state so they do not change this set
      */
-    for(auto const &it : new_automaton.node){
-      for(auto const &symbol : new_automaton.alphabet){
-        if(!new_automaton.transitionBeginWith(it.first, symbol).has_value()){
-          std::set<int> knownNodes;
-          if(!new_automaton.researchFinalStateInDepth(it.first, knownNodes)){
-            new_automaton.addTransition(it.first, symbol, it.first);
-          }else{
-            sink_used = true;
-            new_automaton.addTransition(it.first, symbol, sink);
-          }
+    std::vector<bool> coAccessible(states.size(), false);
+    for(std::size_t i = 0; i < states.size(); i++){
+      if(states[i].final && !coAccessible[i]){
+        researchInSurface(i, coAccessible);
+      }
+    }
+
+    /* the letters missing in every state, found by walking its sorted transitions */
+    std::vector<std::vector<char>> missing(states.size());
+    bool sink_used = false;
+    for(std::size_t i = 0; i < states.size(); i++){
+      auto link = (*edges)[i].begin(), end = (*edges)[i].end();
+      for(char symbol : alphabet){
+        while(link != end && link->letter < symbol){
+          ++link;
+        }
+        if(link == end || link->letter != symbol){
+          missing[i].push_back(symbol);
         }
       }
+      sink_used = sink_used || (coAccessible[i] && !missing[i].empty());
     }
 
-    if(!sink_used){
-      new_automaton.removeState(sink);
+    /* a state that cannot reach a final state loops on itself, the others go to a single sink */
+    int sink_index = -1;
+    if(sink_used){
+      addState(getNumberForNewNode());
+      sink_index = states.size() - 1;
+      missing.emplace_back(alphabet.begin(), alphabet.end());
+      coAccessible.push_back(false);
+    }
+    auto &table = writeEdges();
+    for(std::size_t i = 0; i < states.size(); i++){
+      if(missing[i].empty()){
+        continue;
+      }
+      auto &links = table[i];
+      std::size_t size = links.size();
+      int target = coAccessible[i] ? sink_index : (int)i;
+      for(char symbol : missing[i]){
+        links.push_back({symbol, target});
+      }
+      std::inplace_merge(links.begin(), links.begin() + size, links.end(), isLinkBefore);
+      transitionCount += missing[i].size();
     }
-    return new_automaton;
   }
 
   /**
    * @brief create the complement of the automate
-   * 
+   *
    * @param automaton the automate
-   * @return Automaton 
+   * @return Automaton
    */
   Automaton Automaton::createComplement(const Automaton& automaton){
-    assert(automaton.isValid());
+    Stats stats;
+    return createComplement(automaton, stats);
+  }
 
-    /* create a deterministic finite automaton (DFA) of the original automaton */
-    fa::Automaton deterministic = fa::Automaton::createDeterministic(automaton);
-    fa::Automaton dfa = fa::Automaton::createComplete(deterministic);
+  /**
+   * @brief create the complement of the automate, recording the work done
+   *
+   * @param automaton the automate
+   * @param stats the counters
+   * @return Automaton
+   */
+  Automaton Automaton::createComplement(const Automaton& automaton, Stats& stats){
+    return *createComplement(automaton, stats, Budget());
+  }
 
-    /* create the complement of DFA and initialize the alphabet */
-    fa::Automaton complement;
-    complement.alphabet = dfa.alphabet;
+  /**
+   * @brief create the complement of the automate, unless the budget is exceeded
+   *
+   * @param automaton the automate
+   * @param budget the limits
+   * @return std::optional<Automaton> nothing if the budget is exceeded
+   */
+  std::optional<Automaton> Automaton::createComplement(const Automaton& automaton, const Budget& budget){
+    Stats stats;
+    return createComplement(automaton, stats, budget);
+  }
 
-    /* initialize the nodes*/
-    for(auto &it : dfa.node){
-      complement.addState(it.first);
-      if(dfa.isStateInitial(it.first)){
-        complement.setStateInitial(it.first);
-      }
-      if(!dfa.isStateFinal(it.first)){
-        complement.setStateFinal(it.first);
-      }
+  /**
+   * @brief create the complement of the automate, recording the work done,
+   * unless the budget is exceeded.
+   *
+   * @param automaton the automate
+   * @param stats the counters
+   * @param budget the limits
+   * @return std::optional<Automaton> nothing if the budget is exceeded
+   */
+  std::optional<Automaton> Automaton::createComplement(const Automaton& automaton, Stats& stats, const Budget& budget){
+    assert(automaton.isValid());
+
+    /* create a deterministic finite automaton (DFA) of the original automaton */
+    std::optional<fa::Automaton> deterministic = fa::Automaton::createDeterministic(automaton, 1, stats, budget, std::pmr::get_default_resource());
+    if(!deterministic){
+      return std::nullopt;
     }
-    
-    /*initialize the transitions */
-    complement.transition = dfa.transition;
 
-    return complement;
+    /* the complete automaton has at most one more state, with a transition per letter */
+    std::size_t states = deterministic->countStates() + 1;
+    if(budget.isExceeded(states, states * deterministic->countSymbols())){
+      return std::nullopt;
+    }
+    deterministic->complete();
+    deterministic->swapFinalStates();
+    return deterministic;
   }
 
   /**
-   * @brief create a mirror automaton from a given automate
-   * 
+   * @brief create the complement of the automate, reusing the given automate
+   *
    * @param automaton the automate
-   * @return Automaton 
+   * @return Automaton
    */
-  Automaton Automaton::createMirror(const Automaton& automaton){
-    assert(automaton.isValid());
+  Automaton Automaton::createComplement(Automaton&& automaton){
+    automaton.complement();
+    return std::move(automaton);
+  }
 
-    /* create the mirror of the automaton and initialize the alphabet */
-    fa::Automaton mirror;
-    mirror.alphabet = automaton.alphabet;
+  /**
+   * @brief make the automate accept the complement of its language
+   *
+   */
+  void Automaton::complement(){
+    assert(isValid());
 
-    /* initialize the nodes */
-    for(auto const &it : automaton.node){
-      mirror.addState(it.first);
-      if(automaton.isStateInitial(it.first)){
-        mirror.setStateFinal(it.first);
-      }
-      if(automaton.isStateFinal(it.first)){
-        mirror.setStateInitial(it.first);
-      }
+    if(!isDeterministic()){
+      *this = createDeterministic(*this);
     }
+    complete();
+    swapFinalStates();
+  }
 
-    /* initialize the transitions */
-    for(auto const &it : automaton.transition){
-      mirror.addTransition(it.second.target, it.second.letter, it.first);
+  /**
+   * @brief swap the final and the non-final states.
+   * The complement of a complete DFA has the same states and transitions.
+   *
+   */
+  void Automaton::swapFinalStates(){
+    for(std::size_t i = 0; i < states.size(); i++){
+      if(!isRemoved(i)){
+        states[i].final = !states[i].final;
+      }
     }
+  }
 
+  /**
+   * @brief create a mirror automaton from a given automate
+   *
+   * @param automaton the automate
+   * @return Automaton
+   */
+  Automaton Automaton::createMirror(const Automaton& automaton){
+    fa::Automaton mirror = automaton;
+    mirror.mirror();
     return mirror;
   }
 
+  /**
+   * @brief create a mirror automaton, reusing the given automate
+   *
+   * @param automaton the automate
+   * @return Automaton
+   */
+  Automaton Automaton::createMirror(Automaton&& automaton){
+    automaton.mirror();
+    return std::move(automaton);
+  }
+
+  /**
+   * @brief reverse the transitions and swap the initial and the final states
+   *
+   */
+  void Automaton::mirror(){
+    assert(isValid());
+
+    compact();
+    for(auto &state : states){
+      std::swap(state.initial, state.final);
+    }
+
+    /* the reversed transitions replace the old ones, which are never copied */
+    std::vector<std::vector<Link>> reversed(ids.size());
+    for(std::size_t i = 0; i < edges->size(); i++){
+      for(auto const &link : (*edges)[i]){
+        reversed[link.target].push_back({link.letter, (int)i});
+      }
+    }
+    for(auto &links : reversed){
+      std::sort(links.begin(), links.end(), isLinkBefore);
+    }
+    setEdges(std::move(reversed));
+  }
+
   /**
    * @brief check if the automate only recognize the empty language
    * (ie: you can't create any word)
-   * 
+   *
    * @return true (success)
    * @return false (failure)
    */
   bool Automaton::isLanguageEmpty() const{
     assert(this->isValid());
 
-    /* test if we have at least one final and one initial node */
-    bool hasFinal = false;
-    bool hasInitial = false;
-    for(auto const &it : node){
-      if(isStateFinal(it.first)){
-        hasFinal = true;
+    /* search if we can reach a final state from an initial node */
+    std::vector<bool> knownNodes(states.size(), false);
+    for(std::size_t i = 0; i < states.size(); i++){
+      if(states[i].initial && !knownNodes[i]){
+        if(this->researchFinalStateInDepth(i, knownNodes)){
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief check if the automate accepts every word over its alphabet.
+   *
+   * @return true (success)
+   * @return false (failure)
+   */
+  bool Automaton::isUniversal() const{
+    std::string word;
+    return isUniversal(word);
+  }
+
+  /**
+   * @brief check if the automate accepts every word over its alphabet, without complementing it.
+   * The subsets are explored breadth first until one has no final state, so the word leading to
+   * it is a shortest rejected word. A subset including an explored one is pruned, as the words
+   * rejected from it are also rejected from the smaller one (antichain): only the minimal subsets
+   * are kept.
+   *
+   * @param word set to a shortest word rejected by the automate on failure
+   * @return true (success)
+   * @return false (failure)
+   */
+  bool Automaton::isUniversal(std::string& word) const{
+    assert(this->isValid());
+
+    /* the closures are computed once for all instead of at every step */
+    if(this->hasEpsilonTransition()){
+      return createWithoutEpsilon(*this).isUniversal(word);
+    }
+
+    const std::vector<char> letters(alphabet.begin(), alphabet.end());
+    const std::size_t m = letters.size();
+    std::array<int, 256> letterIndex;
+    for(std::size_t l = 0; l < m; l++){
+      letterIndex[(unsigned char)letters[l]] = l;
+    }
+    auto isRejecting = [&](const StateSet& subset){
+      return std::none_of(subset.begin(), subset.end(), [&](int node){
+        return states[node].final;
+      });
+    };
+
+    /* the subsets are kept with the letter leading to them, to rebuild the word */
+    struct Node{
+      StateSet subset;
+      int parent;
+      char letter;
+    };
+    std::vector<Node> nodes;
+    auto rebuildWord = [&](int node){
+      word.clear();
+      for(; nodes[node].parent != -1; node = nodes[node].parent){
+        word.push_back(nodes[node].letter);
       }
-      if(isStateInitial(it.first)){
-        hasInitial = true;
+      std::reverse(word.begin(), word.end());
+    };
+
+    StateSet subset;
+    for(std::size_t i = 0; i < states.size(); i++){
+      if(states[i].initial){
+        subset.insert(i);
       }
     }
-    if(hasInitial==false || hasFinal==false){
-      return true;
+    if(isRejecting(subset)){
+      word.clear();
+      return false;
     }
+    nodes.push_back(Node{subset, -1, fa::Epsilon});
 
-    /* search if we can reach a final state from an initial node */
-    std::set<int> knownNodes;
-    for(auto const &it : node){
-      if(this->isStateInitial(it.first)){
-        if(this->researchFinalStateInDepth(it.first, knownNodes)){
+    std::vector<int> antichain(1, 0);   // the minimal subsets met
+    std::queue<int> todo;
+    todo.push(0);
+    std::vector<std::vector<int>> targets(m);
+    while(!todo.empty()){
+      int current = todo.front();
+      todo.pop();
+
+      for(int node : nodes[current].subset){
+        for(const Link& link : (*edges)[node]){
+          targets[letterIndex[(unsigned char)link.letter]].push_back(link.target);
+        }
+      }
+
+      for(std::size_t l = 0; l < m; l++){
+        std::sort(targets[l].begin(), targets[l].end());
+        targets[l].erase(std::unique(targets[l].begin(), targets[l].end()), targets[l].end());
+        subset.assign(targets[l].data(), targets[l].data() + targets[l].size());
+        targets[l].clear();
+
+        if(isRejecting(subset)){
+          rebuildWord(current);
+          word.push_back(letters[l]);
           return false;
         }
+        if(std::any_of(antichain.begin(), antichain.end(), [&](int node){ return nodes[node].subset.isIncludedIn(subset); })){
+          continue;
+        }
+
+        /* the subsets including the new one are not minimal anymore */
+        antichain.erase(std::remove_if(antichain.begin(), antichain.end(), [&](int node){
+          return subset.isIncludedIn(nodes[node].subset);
+        }), antichain.end());
+        nodes.push_back(Node{subset, current, letters[l]});
+        antichain.push_back(nodes.size() - 1);
+        todo.push(nodes.size() - 1);
       }
     }
+
     return true;
   }
 
   /**
    * @brief remove the non accessible states from an automate
-   * 
+   *
    */
   void Automaton::removeNonAccessibleStates(){
     assert(this->isValid());
 
     /* store every nodes reachable from a initial node */
-    std::set<int> knownNodes;
-    for(auto const &it : node){
-      if(this->isStateInitial(it.first)){
-        this->researchInDepth(it.first, knownNodes);
+    std::vector<bool> knownNodes(states.size(), false);
+    for(std::size_t i = 0; i < states.size(); i++){
+      if(states[i].initial && !knownNodes[i]){
+        this->researchInDepth(i, knownNodes);
       }
     }
 
     /* remove every nodes (and their transitions) that weren't stored before */
-    for(auto it = node.begin(); it != node.end(); ){
-      if(knownNodes.find(it->first) == knownNodes.end()){
-        it = betterRemoveState(it->first).value();
-      }else{
-        ++it;
-      }
-    }
+    this->removeStates(knownNodes);
 
     /* make the automaton valid if needed */
     if(!this->isValid()){
@@ -823,27 +1585,21 @@ namespace fa {
 
   /**
    * @brief remove the non co-accessible states from an automate
-   * 
+   *
    */
   void Automaton::removeNonCoAccessibleStates(){
     assert(this->isValid());
 
     /* store every nodes that can reach a final node */
-    std::set<int> knownNodes;
-    for(auto const &it : node){
-      if(this->isStateFinal(it.first)){
-        this->researchInSurface(it.first, knownNodes);
+    std::vector<bool> knownNodes(states.size(), false);
+    for(std::size_t i = 0; i < states.size(); i++){
+      if(states[i].final && !knownNodes[i]){
+        this->researchInSurface(i, knownNodes);
       }
     }
 
     /* remove every nodes (and their transitions) that weren't stored before */
-    for(auto it = node.begin(); it != node.end(); ){
-      if(knownNodes.find(it->first) == knownNodes.end()){
-        it = betterRemoveState(it->first).value();
-      }else{
-        ++it;
-      }
-    }
+    this->removeStates(knownNodes);
 
     /* make the automaton valid if needed */
     if(!this->isValid()){
@@ -855,64 +1611,122 @@ namespace fa {
 
   /**
    * @brief create the synchronise product of two automates
-   * 
+   *
    * @param lhs the first automate
    * @param rhs the second automate
-   * @return Automaton 
+   * @return Automaton
    */
   Automaton Automaton::createProduct(const Automaton& lhs, const Automaton& rhs){
+    Stats stats;
+    return createProduct(lhs, rhs, stats);
+  }
+
+  /**
+   * @brief create the synchronise product of two automates, recording the work done
+   *
+   * @param lhs the first automate
+   * @param rhs the second automate
+   * @param stats the counters
+   * @return Automaton
+   */
+  Automaton Automaton::createProduct(const Automaton& lhs, const Automaton& rhs, Stats& stats){
+    return *createProduct(lhs, rhs, stats, Budget());
+  }
+
+  /**
+   * @brief create the synchronise product of two automates, recording the work done,
+   * unless the budget is exceeded.
+   *
+   * @param lhs the first automate
+   * @param rhs the second automate
+   * @param stats the counters
+   * @param budget the limits
+   * @return std::optional<Automaton> nothing if the budget is exceeded
+   */
+  std::optional<Automaton> Automaton::createProduct(const Automaton& lhs, const Automaton& rhs, [[maybe_unused]] Stats& stats, const Budget& budget){
     assert(lhs.isValid());
     assert(rhs.isValid());
 
+    Scratch scratch(std::pmr::get_default_resource());
+    FA_STATS(PhaseScope phase(stats, "pairs", scratch));
+
     /* create the product of the automaton and initialize the alphabet */
     fa::Automaton product;
     product.alphabet = fa::Automaton::createAlphabetProduct(lhs.alphabet, rhs.alphabet);
-    
+
+    /* the number of a node of the product is its index */
+    std::pmr::map<std::pair<int, int>, int> nodes(scratch.get());
+    std::queue<std::pair<int, int>, std::pmr::deque<std::pair<int, int>>> pending(scratch.get());
+    auto getNode = [&](int node_lhs, int node_rhs){
+      auto key = nodes.find(std::make_pair(node_lhs, node_rhs));
+      if(key != nodes.end()){
+        return key->second;
+      }
+      int n = product.ids.size();
+      nodes[std::make_pair(node_lhs, node_rhs)] = n;
+      product.addState(n);
+      if(lhs.states[node_lhs].final && rhs.states[node_rhs].final){
+        product.states[n].final = true;
+      }
+      pending.push(std::make_pair(node_lhs, node_rhs));
+      return n;
+    };
+
     /* initialize the nodes */
-    std::map<std::pair<int, int>, int> nodes;
-    int n=0;
-    for(auto const &it_lhs : lhs.node){
-      if(lhs.isStateInitial(it_lhs.first)){
-        for(auto const &it_rhs : rhs.node){
-          if(rhs.isStateInitial(it_rhs.first)){
-            nodes[std::make_pair(it_lhs.first, it_rhs.first)] = n;
-            product.addState(n);
-            product.setStateInitial(n);
-            if(lhs.isStateFinal(it_lhs.first) && rhs.isStateFinal(it_rhs.first)){
-              product.setStateFinal(n);
-            }
-            n++;
+    for(std::size_t i_lhs = 0; i_lhs < lhs.states.size(); i_lhs++){
+      if(lhs.states[i_lhs].initial){
+        for(std::size_t i_rhs = 0; i_rhs < rhs.states.size(); i_rhs++){
+          if(rhs.states[i_rhs].initial){
+            product.states[getNode(i_lhs, i_rhs)].initial = true;
           }
         }
       }
     }
 
-    /* initialize the transitions */
-    for(auto const &it : nodes){
-      for(auto const &letter : product.alphabet){
-        auto rtn_lhs=lhs.transitionBeginWith(it.first.first, letter);
-        auto rtn_rhs=rhs.transitionBeginWith(it.first.second, letter);
+    /* initialize the transitions, both lists of transitions are sorted by letter */
+    while(!pending.empty()){
+      auto current = pending.front();
+      pending.pop();
+      int from = nodes[current];
+      FA_STATS(if((from & 0xFFF) == 0xFFF){ reportProgress(stats, product.ids.size(), product.transitionCount); });
+      if((from & 0xFF) == 0 && budget.isExceeded(product.ids.size(), product.transitionCount)){
+        return std::nullopt;
+      }
 
-        if(rtn_lhs.has_value() && rtn_rhs.has_value()){
-          for(int node_lhs : rtn_lhs.value()){
-            for(int node_rhs : rtn_rhs.value()){
-              auto key = nodes.find(std::pair<int, int>(node_lhs, node_rhs));
-              if(key == nodes.end()){    //si le noeud n'existe pas, on l'ajoute et on lui assigne un id
-                nodes[std::make_pair(node_lhs, node_rhs)] = n;
-                product.addState(n);
-                product.addTransition(it.second, letter, n);
-                if(lhs.isStateFinal(node_lhs) && rhs.isStateFinal(node_rhs)){
-                  product.setStateFinal(n);
-                }
-                n++;
-              }else{    //sinon on récupère son id
-                product.addTransition(it.second, letter, key->second);
+      auto const &links_lhs = (*lhs.edges)[current.first];
+      auto const &links_rhs = (*rhs.edges)[current.second];
+      auto it_lhs = links_lhs.begin();
+      auto it_rhs = links_rhs.begin();
+      while(it_lhs != links_lhs.end() && it_rhs != links_rhs.end()){
+        if(it_lhs->letter < it_rhs->letter){
+          ++it_lhs;
+        }else if(it_rhs->letter < it_lhs->letter){
+          ++it_rhs;
+        }else{
+          char letter = it_lhs->letter;
+          auto end_lhs = it_lhs;
+          while(end_lhs != links_lhs.end() && end_lhs->letter == letter){
+            ++end_lhs;
+          }
+          auto end_rhs = it_rhs;
+          while(end_rhs != links_rhs.end() && end_rhs->letter == letter){
+            ++end_rhs;
+          }
+          if(letter != fa::Epsilon){
+            for(auto link_lhs = it_lhs; link_lhs != end_lhs; ++link_lhs){
+              for(auto link_rhs = it_rhs; link_rhs != end_rhs; ++link_rhs){
+                int to = getNode(link_lhs->target, link_rhs->target);
+                product.addLink(from, letter, to);
               }
             }
           }
+          it_lhs = end_lhs;
+          it_rhs = end_rhs;
         }
       }
     }
+    FA_STATS(stats.productPairs += nodes.size());
+    FA_STATS(reportProgress(stats, product.ids.size(), product.transitionCount));
 
     /* make the automaton valid if needed */
     if(!product.isValid()){
@@ -932,7 +1746,7 @@ namespace fa {
 
   /**
    * @brief check if the intersection of two automates is empty
-   * 
+   *
    * @param other the second automate
    * @return true (success)
    * @return false (failure)
@@ -947,35 +1761,51 @@ namespace fa {
 
   /**
    * @brief navigate through the automate to read the word
-   * 
+   *
    * @param word the word to pass
-   * @return std::set<int> the last node after iterring through the automate
+   * @return StateSet the last node after iterring through the automate
    */
-  std::set<int> Automaton::readString(const std::string& word) const{
+  StateSet Automaton::readString(const std::string& word) const{
     assert(this->isValid());
 
-    std::set<int> rtn;
-    for(auto const &it : this->node){
-      if(this->isStateInitial(it.first)){
-        rtn.merge(this->getLastNodesOfTheWord(it.first, word));
+    StateSet initial;
+    for(std::size_t i = 0; i < states.size(); i++){
+      if(states[i].initial){
+        initial.insert(i);
       }
     }
 
+    /* the numbers of the nodes are not in the order of their indexes */
+    std::vector<int> numbers;
+    for(int node : this->getLastNodesOfTheWord(initial, word)){
+      numbers.push_back(ids[node]);
+    }
+    std::sort(numbers.begin(), numbers.end());
+
+    StateSet rtn;
+    rtn.assign(numbers.data(), numbers.data() + numbers.size());
     return rtn;
   }
 
   /**
    * @brief check if the word is in the language of the automate
-   * 
+   *
    * @param word the word to pass
    * @return true (success)
    * @return false (failure)
    */
   bool Automaton::match(const std::string& word) const{
-    std::set<int> nodes = readString(word);
+    assert(this->isValid());
+
+    StateSet initial;
+    for(std::size_t i = 0; i < states.size(); i++){
+      if(states[i].initial){
+        initial.insert(i);
+      }
+    }
 
-    for(auto node : nodes){
-      if(this->isStateFinal(node)){
+    for(int node : this->getLastNodesOfTheWord(initial, word)){
+      if(states[node].final){
         return true;
       }
     }
@@ -984,244 +1814,1944 @@ namespace fa {
   }
 
   /**
-   * @brief create the deterministic version of the automate
-   * 
-   * @param automaton the automate
-   * @return Automaton 
+   * @brief mix a value into a hash.
+   *
+   * @param hash the current hash
+   * @param value the value to add
+   * @return std::size_t
    */
-  Automaton Automaton::createDeterministic(const Automaton& automaton){
-    assert(automaton.isValid());
+  static std::size_t combineHash(std::size_t hash, std::size_t value){
+    return hash ^ (value + 0x9e3779b9 + (hash << 6) + (hash >> 2));
+  }
 
-    if(automaton.isDeterministic()){
-      return automaton;
+  /**
+   * @brief a subset -> id table shared by the threads of the subset construction.
+   * The subsets are spread over shards, each one protected by its own mutex.
+   * The ids are taken from a shared counter, so they depend on the scheduling.
+   */
+  class SubsetTable{
+  public:
+    SubsetTable(std::size_t count, std::pmr::memory_resource* upstream)
+    : mask(count - 1), counter(0){
+      assert((count & mask) == 0);
+      for(std::size_t shard = 0; shard < count; shard++){
+        shards.push_back(std::make_unique<Shard>(upstream));
+      }
     }
-    /* create the deterministic version of the automaton and initialize the alphabet */
-    fa::Automaton deterministic;
-    deterministic.alphabet = automaton.alphabet;
 
-    /* initialize the initial nodes */
-    std::map<int, std::set<int>> nodes;
-    bool isFinal = false;
-    int n = 0;
-    std::set<int> initial;
-    for(auto const &it : automaton.node){
-      if(automaton.isStateInitial(it.first)){
-        initial.insert(it.first);
-        if(!isFinal && automaton.isStateFinal(it.first)){
-          isFinal = true;
-        }
+    /**
+     * @brief find the id of a subset, or give it a new id.
+     *
+     * @param subset the indexes of the states, copied in the table if added
+     * @return the id, the stored subset (its address does not change) and true if it was added
+     */
+    std::tuple<int, const StateSet*, bool> insert(const StateSet& subset){
+      Shard& shard = *shards[subset.hash() & mask];
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto key = shard.ids.find(subset);
+      if(key != shard.ids.end()){
+        return {key->second, &key->first, false};
       }
+      int id = counter.fetch_add(1);
+      key = shard.ids.emplace(StateSet(subset, &shard.arena), id).first;
+      return {id, &key->first, true};
     }
-    nodes[n] = initial;
-    deterministic.addState(n);
-    if(isFinal){
-      deterministic.setStateFinal(n);
-    }
-    deterministic.setStateInitial(n++);
-
-    /* initialize the nodes */
-    for(auto &it : nodes){
-      for(char letter : deterministic.alphabet){
-        std::set<int> new_nodes;
-        isFinal = false;
-        for(auto &node : it.second){
-          /* store the older nodes that are the target of the given transition */
-          auto target = automaton.transitionBeginWith(node, letter);
-          if(target.has_value()){
-            new_nodes.merge(target.value());
-          }
-        }
 
-        if(new_nodes.size() > 0){
-          std::map<int, std::set<int>>::iterator key;
-          /* find the key matching all the older nodes*/
-          for(key = nodes.begin(); key != nodes.end(); ++key){
-            if (key->second == new_nodes){
-              break;
-            }
-          }
+    int size() const{
+      return counter.load();
+    }
 
-          /* initialize the transitions */
-          if(key != nodes.end()){     //if the key exist create a transition toward the node associated
-            deterministic.addTransition(it.first, letter, key->first);
-          }else{      //if the key doesn't exist create the node, the transition and find if it is final
-            nodes[n] = new_nodes;
-            deterministic.addState(n);
-            for(auto finalNode = new_nodes.begin(); !isFinal && finalNode != new_nodes.end(); finalNode++){
-              if(automaton.isStateFinal(*finalNode)){
-                deterministic.setStateFinal(n);
-              }
-            }
-            deterministic.addTransition(it.first, letter, n++);
-          }
-        }
+  private:
+    /* the subsets of a shard are copied in its own arena, only used under its mutex */
+    struct Shard{
+      explicit Shard(std::pmr::memory_resource* upstream)
+      : arena(upstream), ids(&arena){
       }
-    }
 
-    /* make the automaton valid if needed */
-    if(!deterministic.isValid()){
-      fa::Automaton new_deterministic;
-      deterministic=new_deterministic;
-      deterministic.addState(42);
-      deterministic.setStateInitial(42);
-      deterministic.addSymbol('q');
-    }
+      std::mutex mutex;
+      std::pmr::monotonic_buffer_resource arena;
+      std::pmr::unordered_map<StateSet, int> ids;
+    };
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::size_t mask;
+    std::atomic<int> counter;
+  };
 
-    return deterministic;
+  /**
+   * @brief create the deterministic version of the automate.
+   * The subset construction goes level by level: the subsets of a level are shared
+   * between the threads, which compute their successors and register the new subsets
+   * in a concurrent table. The ids are then renumbered in breadth-first order, so the
+   * result does not depend on the number of threads.
+   *
+   * @param automaton the automate
+   * @param threads the number of threads (0 for one per core)
+   * @return Automaton
+   */
+  Automaton Automaton::createDeterministic(const Automaton& automaton, unsigned threads){
+    Stats stats;
+    return createDeterministic(automaton, threads, stats);
   }
 
   /**
-   * @brief check if the language of an automate is include in another one.
-   * 
-   * @param other the other automate
-   * @return true (success)
-   * @return false (failure)
+   * @brief create the deterministic version of the automate, recording the work done
+   *
+   * @param automaton the automate
+   * @param threads the number of threads (0 for one per core)
+   * @param stats the counters
+   * @return Automaton
    */
-  bool Automaton::isIncludedIn(const Automaton& other) const{
-    assert(this->isValid());
-    assert(other.isValid());
+  Automaton Automaton::createDeterministic(const Automaton& automaton, unsigned threads, Stats& stats){
+    return *createDeterministic(automaton, threads, stats, Budget(), std::pmr::get_default_resource());
+  }
 
-    fa::Automaton _other = other;
-    if(this->alphabet != other.alphabet){
-      for(auto const letter : this->alphabet){
-        if(!_other.hasSymbol(letter)){
-          _other.addSymbol(letter);
-        }
-      }
-    }
+  /**
+   * @brief create the deterministic version of the automate, unless the budget is exceeded
+   *
+   * @param automaton the automate
+   * @param budget the limits
+   * @param threads the number of threads (0 for one per core)
+   * @return std::optional<Automaton> nothing if the budget is exceeded
+   */
+  std::optional<Automaton> Automaton::createDeterministic(const Automaton& automaton, const Budget& budget, unsigned threads){
+    Stats stats;
+    return createDeterministic(automaton, threads, stats, budget, std::pmr::get_default_resource());
+  }
 
-    return this->hasEmptyIntersectionWith(fa::Automaton::createComplement(_other));
+  /**
+   * @brief create the deterministic version of the automate, the temporary structures
+   * drawn from the given memory resource.
+   *
+   * @param automaton the automate
+   * @param threads the number of threads (0 for one per core)
+   * @param resource the memory of the temporary structures, thread-safe if several threads
+   * @return Automaton
+   */
+  Automaton Automaton::createDeterministic(const Automaton& automaton, unsigned threads, std::pmr::memory_resource* resource){
+    Stats stats;
+    return *createDeterministic(automaton, threads, stats, Budget(), resource);
   }
 
   /**
-   * @brief create the minimal version of the automate using the Moore algorithm
-   * 
+   * @brief create a deterministic automaton, reusing the given automate if it is already deterministic
+   *
    * @param automaton the automate
-   * @return Automaton 
+   * @param threads the number of threads, 0 for one per core
+   * @return Automaton
    */
-  Automaton Automaton::createMinimalMoore(const Automaton& automaton){
+  Automaton Automaton::createDeterministic(Automaton&& automaton, unsigned threads){
     assert(automaton.isValid());
 
-    /* create a deterministic finite automaton (DFA) of the original automaton */
-    fa::Automaton deterministic = fa::Automaton::createDeterministic(automaton);
-    fa::Automaton dfa = fa::Automaton::createComplete(deterministic);
-    dfa.removeNonAccessibleStates();
+    if(automaton.isDeterministic()){
+      return std::move(automaton);
+    }
+    return createDeterministic(static_cast<const Automaton&>(automaton), threads);
+  }
 
-    /* create the minimal of DFA and initialize the alphabet */
-    fa::Automaton minimal;
-    minimal.alphabet = dfa.alphabet;
+  /**
+   * @brief create the deterministic version of the automate, recording the work done,
+   * unless the budget is exceeded. The budget is checked before every chunk of subsets.
+   * The subsets are copied in the arenas of the shards of the table, the successors
+   * are computed in the arenas of the threads.
+   *
+   * @param automaton the automate
+   * @param threads the number of threads (0 for one per core)
+   * @param stats the counters
+   * @param budget the limits
+   * @param resource the memory of the temporary structures
+   * @return std::optional<Automaton> nothing if the budget is exceeded
+   */
+  std::optional<Automaton> Automaton::createDeterministic(const Automaton& automaton, unsigned threads, Stats& stats, const Budget& budget, std::pmr::memory_resource* resource){
+    assert(automaton.isValid());
 
-    /* initialize the nodes*/
-    std::map<int, int> moore, mooreBis; //array to store the number of an original node with a new node
-    for(auto from : dfa.node){
-      if(dfa.isStateFinal(from.first)){
-        moore[from.first] = 2;  //final nodes
-      }else{
-        moore[from.first] = 1;  //other nodes
+    if(automaton.isDeterministic()){
+      if(budget.isExceeded(automaton.countStates(), automaton.countTransitions())){
+        return std::nullopt;
       }
+      return automaton;
     }
+    return createSubsets(automaton, false, threads, stats, budget, resource);
+  }
 
+  /**
+   * @brief the subset construction of the automate or of its mirror, unless the budget is exceeded.
+   * The mirror is never built: its transitions are read from the predecessors of the
+   * automate, its initial states are the final states of the automate and conversely.
+   * The epsilon transitions are followed through the closures of the states, computed once.
+   *
+   * @param automaton the automate
+   * @param mirrored true to determinize the mirror of the automate
+   * @param threads the number of threads (0 for one per core)
+   * @param stats the counters
+   * @param budget the limits
+   * @param resource the upstream of the temporary structures
+   * @return std::optional<Automaton> nothing if the budget is exceeded
+   */
+  std::optional<Automaton> Automaton::createSubsets(const Automaton& automaton, bool mirrored, unsigned threads, [[maybe_unused]] Stats& stats, const Budget& budget, std::pmr::memory_resource* resource){
+    if(threads == 0){
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    /* the letters are numbered in the order of the alphabet */
+    std::vector<char> letters(automaton.alphabet.begin(), automaton.alphabet.end());
+    std::array<int, 256> letterIndex;
+    letterIndex.fill(-1);
+    for(std::size_t l = 0; l < letters.size(); l++){
+      letterIndex[(unsigned char)letters[l]] = l;
+    }
+
+    Scratch scratch(resource);
+    const std::size_t m = letters.size();
+    std::size_t shards = 1;
+    while(shards < 16 * threads){
+      shards <<= 1;
+    }
+    SubsetTable known(shards, scratch.upstream());
+    std::pmr::vector<const StateSet*> nodes(scratch.get());                // id -> subset
+    std::pmr::vector<int> delta(scratch.get());                            // id * m + letter -> target, -1 if none
+
+    /* the transitions of the mirror are the predecessors */
+    const std::size_t n = automaton.states.size();
+    const Predecessors* predecessors = mirrored ? &automaton.getPredecessors() : nullptr;
+    auto linksOf = [&](int node) -> std::pair<const Link*, const Link*>{
+      if(mirrored){
+        const Link* links = predecessors->links.data();
+        return {links + predecessors->begin[node], links + predecessors->begin[node + 1]};
+      }
+      auto const &links = (*automaton.edges)[node];
+      return {links.data(), links.data() + links.size()};
+    };
+    auto isInitial = [&](int node){
+      return mirrored ? automaton.states[node].final : automaton.states[node].initial;
+    };
+    auto isFinal = [&](int node){
+      return mirrored ? automaton.states[node].initial : automaton.states[node].final;
+    };
 
-    //<new node, <<letter, new node target>*, result node>
-    std::map<std::pair<int, std::vector<std::pair<char, int>>>, int> transitions;
-    do{
-      int n=1;
-      transitions.clear();
-      mooreBis = moore;
-
-      for(auto from : dfa.node){
-        /* store the transitions for a given node */
-        std::pair<int, std::vector<std::pair<char, int>>> key;
-        key.first = mooreBis[from.first];
-        auto rtn = dfa.transition.equal_range(from.first);
-        for(auto const letter : dfa.alphabet){
-          for(auto it = rtn.first; it != rtn.second; it++){
-            if(it->second.letter == letter){
-              key.second.push_back(std::make_pair(letter, mooreBis[it->second.target]));
+    /*
+     * the epsilon closure of every state is computed once, and replaces the state in the subsets;
+     * it only keeps the states that are final or read a letter, the others changing nothing
+     */
+    const bool epsilon = automaton.hasEpsilonTransition();
+    std::pmr::vector<std::size_t> closureBegin(scratch.get());     // state -> first state of its closure, n + 1 entries
+    std::pmr::vector<int> closures(scratch.get());
+    if(epsilon){
+      std::pmr::vector<bool> knownNodes(n, false, scratch.get());
+      std::pmr::vector<int> reached(scratch.get());
+      for(std::size_t node = 0; node < n; node++){
+        closureBegin.push_back(closures.size());
+        knownNodes[node] = true;
+        reached.push_back(node);
+        for(std::size_t i = 0; i < reached.size(); i++){
+          auto links = linksOf(reached[i]);
+          const Link* link = links.first;
+          for(; link != links.second && link->letter == fa::Epsilon; ++link){
+            if(!knownNodes[link->target]){
+              knownNodes[link->target] = true;
+              reached.push_back(link->target);
             }
           }
+          if(link != links.second || isFinal(reached[i])){
+            closures.push_back(reached[i]);
+          }
         }
+        std::sort(closures.begin() + closureBegin.back(), closures.end());
+        for(int reachedNode : reached){
+          knownNodes[reachedNode] = false;
+        }
+        reached.clear();
+      }
+      closureBegin.push_back(closures.size());
+    }
+    auto addClosure = [&](int node, auto& targets){
+      if(!epsilon){
+        targets.push_back(node);
+        return;
+      }
+      targets.insert(targets.end(), closures.begin() + closureBegin[node], closures.begin() + closureBegin[node + 1]);
+    };
+
+    /* every thread computes the successors in its own arena */
+    struct Worker{
+      Worker(std::pmr::memory_resource* upstream, std::size_t letters)
+      : arena(upstream), new_nodes(letters, &arena), subset(&arena), found(&arena){
+      }
 
-        std::map<std::pair<int, std::vector<std::pair<char, int>>>, int>::iterator it;
-        /* find the iterator matching the key */
-        for(it = transitions.begin(); it != transitions.end(); it++){
-          if(it->first == key){
-            break;
+      std::pmr::monotonic_buffer_resource arena;
+      std::pmr::vector<std::pmr::vector<int>> new_nodes;            // letter -> targets
+      StateSet subset;                                              // the targets of a letter
+      std::pmr::vector<std::pair<int, const StateSet*>> found;      // the new subsets
+    };
+    std::vector<std::unique_ptr<Worker>> workerData;
+
+    /* initialize the initial node */
+    std::pmr::vector<int> initials(scratch.get());
+    for(std::size_t i = 0; i < n; i++){
+      if(isInitial(i)){
+        addClosure(i, initials);
+      }
+    }
+    std::sort(initials.begin(), initials.end());
+    initials.erase(std::unique(initials.begin(), initials.end()), initials.end());
+    StateSet initial(scratch.get());
+    initial.assign(initials.data(), initials.data() + initials.size());
+    nodes.push_back(std::get<1>(known.insert(initial)));
+    std::pmr::vector<int> frontier(1, 0, scratch.get());
+
+    /* explore the subsets level by level */
+    const std::size_t chunk = 16;
+    std::atomic<std::size_t> transitions(0);
+    std::atomic<bool> exceeded(false);
+    FA_STATS(std::optional<PhaseScope> phase(std::in_place, stats, "subsets", scratch));
+    while(!frontier.empty()){
+      delta.resize(nodes.size() * m, -1);
+      FA_STATS(stats.subsetsExplored += frontier.size());
+
+      unsigned workers = std::min<std::size_t>(threads, (frontier.size() + chunk - 1) / chunk);
+      while(workerData.size() < workers){
+        workerData.push_back(std::make_unique<Worker>(scratch.upstream(), m));
+      }
+      std::atomic<std::size_t> next(0);
+
+      auto work = [&](unsigned worker){
+        std::pmr::vector<std::pmr::vector<int>>& new_nodes = workerData[worker]->new_nodes;
+        StateSet& subset = workerData[worker]->subset;
+        std::pmr::vector<std::pair<int, const StateSet*>>& found = workerData[worker]->found;
+        found.clear();
+        for(std::size_t begin; (begin = next.fetch_add(chunk)) < frontier.size(); ){
+          if(exceeded.load(std::memory_order_relaxed) || budget.isExceeded(known.size(), transitions.load(std::memory_order_relaxed))){
+            exceeded.store(true, std::memory_order_relaxed);
+            return;
           }
-        }
+          std::size_t end = std::min(begin + chunk, frontier.size());
+          std::size_t added = 0;
+          for(std::size_t f = begin; f < end; f++){
+            int from = frontier[f];
+
+            /* store the older nodes that are the target of every letter */
+            for(int node : *nodes[from]){
+              auto links = linksOf(node);
+              for(const Link* link = links.first; link != links.second; ++link){
+                if(link->letter != fa::Epsilon){
+                  addClosure(link->target, new_nodes[letterIndex[(unsigned char)link->letter]]);
+                }
+              }
+            }
 
-        if(it != transitions.end()){      //if the iterator exist set to the node associated
-          moore[from.first] = it->second;
-        }else{      //if the iterator doesn't exist create the transition and update the node associated
-          transitions[key] = n;
-          moore[from.first] = n++;
+            for(std::size_t l = 0; l < m; l++){
+              std::pmr::vector<int>& targets = new_nodes[l];
+              if(targets.empty()){
+                continue;
+              }
+              std::sort(targets.begin(), targets.end());
+              targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+              subset.assign(targets.data(), targets.data() + targets.size());
+              targets.clear();
+
+              auto rtn = known.insert(subset);
+              delta[from * m + l] = std::get<0>(rtn);
+              if(std::get<2>(rtn)){
+                found.push_back({std::get<0>(rtn), std::get<1>(rtn)});
+              }
+              added++;
+            }
+          }
+          transitions.fetch_add(added, std::memory_order_relaxed);
         }
+      };
+
+      std::vector<std::thread> pool;
+      for(unsigned worker = 1; worker < workers; worker++){
+        pool.emplace_back(work, worker);
+      }
+      work(0);
+      for(auto &thread : pool){
+        thread.join();
+      }
+      if(exceeded.load()){
+        return std::nullopt;
       }
-    }while(mooreBis != moore);
 
-    /* set the nodes*/
-    for(auto const node : moore){
-      minimal.addState(node.second);
-      if(dfa.isStateInitial(node.first)){
-        minimal.setStateInitial(node.second);
+      /* the new subsets are the next level */
+      nodes.resize(known.size());
+      frontier.clear();
+      for(unsigned worker = 0; worker < workers; worker++){
+        for(auto const &it : workerData[worker]->found){
+          nodes[it.first] = it.second;
+          frontier.push_back(it.first);
+        }
+      }
+      std::sort(frontier.begin(), frontier.end());
+      FA_STATS(reportProgress(stats, nodes.size(), 0));
+    }
+    FA_STATS(phase.emplace(stats, "renumbering", scratch));
+
+    /* renumber the nodes in breadth-first order, the letters taken in order */
+    std::pmr::vector<int> order(1, 0, scratch.get());
+    std::pmr::vector<int> renumber(nodes.size(), -1, scratch.get());
+    renumber[0] = 0;
+    for(std::size_t current = 0; current < order.size(); current++){
+      for(std::size_t l = 0; l < m; l++){
+        int to = delta[order[current] * m + l];
+        if(to >= 0 && renumber[to] < 0){
+          renumber[to] = order.size();
+          order.push_back(to);
+        }
       }
+    }
 
-      if(dfa.isStateFinal(node.first)){
-        minimal.setStateFinal(node.second);
+    /* create the deterministic version of the automaton and initialize the alphabet */
+    fa::Automaton deterministic;
+    deterministic.alphabet = automaton.alphabet;
+    for(std::size_t d = 0; d < order.size(); d++){
+      deterministic.addState(d);
+      for(int node : *nodes[order[d]]){
+        if(isFinal(node)){
+          deterministic.states[d].final = true;
+          break;
+        }
       }
     }
+    deterministic.states[0].initial = true;
 
-    /*set the transitions */
-    for(auto const trans : transitions){
-      for(auto const target : trans.first.second){
-        minimal.addTransition(trans.first.first, target.first, target.second);
+    /* initialize the transitions, one per letter taken in order so they are already sorted */
+    auto &table = deterministic.writeEdges();
+    for(std::size_t d = 0; d < order.size(); d++){
+      for(std::size_t l = 0; l < m; l++){
+        int to = delta[order[d] * m + l];
+        if(to >= 0){
+          table[d].push_back({letters[l], renumber[to]});
+          deterministic.transitionCount++;
+        }
       }
     }
+    FA_STATS(reportProgress(stats, deterministic.ids.size(), deterministic.transitionCount));
 
-    return minimal;
+    return deterministic;
   }
 
   /**
-   * @brief create the minimal version of the automate using the Brzozowski algorithm
-   * 
-   * @param automaton the automate
-   * @return Automaton 
+   * @brief check if the language of an automate is include in another one.
+   *
+   * @param other the other automate
+   * @return true (success)
+   * @return false (failure)
    */
-  Automaton Automaton::createMinimalBrzozowski(const Automaton& automaton){
-    assert(automaton.isValid());
-
-    fa::Automaton mirrored = fa::Automaton::createMirror(automaton);
-    fa::Automaton deterministicMirror = fa::Automaton::createDeterministic(mirrored);
-
-    fa::Automaton mirroredbis = fa::Automaton::createMirror(deterministicMirror);
-    fa::Automaton minimal = fa::Automaton::createDeterministic(mirroredbis);
-    
-    return fa::Automaton::createComplete(minimal);
+  bool Automaton::isIncludedIn(const Automaton& other) const{
+    Stats stats;
+    return isIncludedIn(other, stats);
   }
-  
-
 
   /**
-   * @brief remove the epsilon transitions of the automate
-   * 
-   * @param automaton the automate
-   * @return Automaton 
+   * @brief check if the language of an automate is include in another one,
+   * recording the work done.
+   *
+   * @param other the other automate
+   * @param stats the counters
+   * @return true (success)
+   * @return false (failure)
    */
-  Automaton Automaton::createWithoutEpsilon(const Automaton& automaton){
-    assert(automaton.isValid());
-
-    /* create the automaton without epsilon*/
-    fa::Automaton automaton_no_epsilon = automaton;
-    std::set<int> knownNodes;
+  bool Automaton::isIncludedIn(const Automaton& other, Stats& stats) const{
+    return *isIncludedIn(other, stats, Budget());
+  }
 
-    if(automaton_no_epsilon.hasEpsilonTransition()){
-      for(const auto &initial : automaton_no_epsilon.node){
-        if(automaton_no_epsilon.isStateInitial(initial.first)){
-          automaton_no_epsilon.removeEpsilonTransition(initial.first, knownNodes);
+  /**
+   * @brief check if the language of an automate is include in another one,
+   * unless the budget is exceeded.
+   *
+   * @param other the other automate
+   * @param budget the limits
+   * @return std::optional<bool> nothing if the budget is exceeded
+   */
+  std::optional<bool> Automaton::isIncludedIn(const Automaton& other, const Budget& budget) const{
+    Stats stats;
+    return isIncludedIn(other, stats, budget);
+  }
+
+  /**
+   * @brief check if the language of an automate is include in another one,
+   * recording the work done, unless the budget is exceeded.
+   *
+   * @param other the other automate
+   * @param stats the counters
+   * @param budget the limits
+   * @return std::optional<bool> nothing if the budget is exceeded
+   */
+  std::optional<bool> Automaton::isIncludedIn(const Automaton& other, Stats& stats, const Budget& budget) const{
+    assert(this->isValid());
+    assert(other.isValid());
+
+    fa::Automaton _other = other;
+    if(this->alphabet != other.alphabet){
+      for(auto const letter : this->alphabet){
+        if(!_other.hasSymbol(letter)){
+          _other.addSymbol(letter);
+        }
+      }
+    }
+
+    std::optional<fa::Automaton> complement = fa::Automaton::createComplement(_other, stats, budget);
+    if(!complement){
+      return std::nullopt;
+    }
+    std::optional<fa::Automaton> product = createProduct(*this, *complement, stats, budget);
+    if(!product){
+      return std::nullopt;
+    }
+    return product->isLanguageEmpty();
+  }
+
+  /**
+   * @brief check if two automata accept the same language.
+   *
+   * @param other the other automate
+   * @return true (success)
+   * @return false (failure)
+   */
+  bool Automaton::isEquivalentTo(const Automaton& other) const{
+    std::string word;
+    return isEquivalentTo(other, word);
+  }
+
+  /**
+   * @brief check if two automata accept the same language with the algorithm of Bonchi and Pous
+   * (HKC). The pairs of subsets of the two automata are explored lazily, breadth first. A pair is
+   * skipped if its subsets were already merged in a union-find, or if it follows from the pairs
+   * already checked by congruence: a subset is saturated with these pairs, a pair (X', Y') adding
+   * Y' once X' is included and conversely, and the pair follows if both subsets reach the same
+   * saturation.
+   *
+   * @param other the other automate
+   * @param word set to a word accepted by only one of the automata on failure
+   * @return true (success)
+   * @return false (failure)
+   */
+  bool Automaton::isEquivalentTo(const Automaton& other, std::string& word) const{
+    assert(this->isValid());
+    assert(other.isValid());
+
+    /* the closures are computed once for all instead of at every step */
+    if(this->hasEpsilonTransition()){
+      return createWithoutEpsilon(*this).isEquivalentTo(other, word);
+    }
+    if(other.hasEpsilonTransition()){
+      return this->isEquivalentTo(createWithoutEpsilon(other), word);
+    }
+
+    /* the states of the other automate come after ours, the letters are the union of the alphabets */
+    const std::size_t offset = this->states.size();
+    const std::size_t n = offset + other.states.size();
+    std::vector<char> letters;
+    std::set_union(this->alphabet.begin(), this->alphabet.end(), other.alphabet.begin(), other.alphabet.end(), std::back_inserter(letters));
+    const std::size_t m = letters.size();
+    std::array<int, 256> letterIndex;
+    for(std::size_t l = 0; l < m; l++){
+      letterIndex[(unsigned char)letters[l]] = l;
+    }
+    auto linksOf = [&](int node) -> const std::vector<Link>&{
+      return node < (int)offset ? (*this->edges)[node] : (*other.edges)[node - offset];
+    };
+    auto isFinal = [&](int node){
+      return node < (int)offset ? this->states[node].final : other.states[node - offset].final;
+    };
+
+    /* every subset met has an id, a union-find class and, once needed, its successors */
+    Scratch scratch(std::pmr::get_default_resource());
+    SubsetTable known(1, scratch.upstream());
+    std::vector<const StateSet*> nodes;
+    std::vector<bool> finals;
+    std::vector<int> classes;
+    std::vector<int> delta;   // id * m + letter -> target, -1 if not computed yet
+    auto insert = [&](const StateSet& subset){
+      auto rtn = known.insert(subset);
+      if(std::get<2>(rtn)){
+        nodes.push_back(std::get<1>(rtn));
+        finals.push_back(std::any_of(subset.begin(), subset.end(), isFinal));
+        classes.push_back(std::get<0>(rtn));
+        delta.resize(delta.size() + m, -1);
+      }
+      return std::get<0>(rtn);
+    };
+    auto find = [&](int id){
+      while(classes[id] != id){
+        classes[id] = classes[classes[id]];
+        id = classes[id];
+      }
+      return id;
+    };
+
+    std::vector<std::vector<int>> targets(m);
+    StateSet subset(scratch.get());
+    auto computeSuccessors = [&](int id){
+      for(int node : *nodes[id]){
+        for(const Link& link : linksOf(node)){
+          targets[letterIndex[(unsigned char)link.letter]].push_back(link.target + (node < (int)offset ? 0 : offset));
+        }
+      }
+      for(std::size_t l = 0; l < m; l++){
+        std::sort(targets[l].begin(), targets[l].end());
+        targets[l].erase(std::unique(targets[l].begin(), targets[l].end()), targets[l].end());
+        subset.assign(targets[l].data(), targets[l].data() + targets[l].size());
+        targets[l].clear();
+        int target = insert(subset);
+        delta[id * m + l] = target;
+      }
+    };
+
+    /*
+     * the checked pairs, as rewriting rules indexed by the states of their sides: a side
+     * applies once all its states are in the saturated subset, counted by its counter
+     */
+    std::vector<std::pair<int, int>> rules;
+    std::vector<std::vector<int>> occurrences(n);   // state -> rule * 2 + side
+    std::vector<int> counters;
+    std::vector<int> unconditional;                 // the empty sides, always applied
+    std::vector<bool> saturated(n, false);
+    std::vector<int> reached, touched;
+
+    /* saturate the first subset, stopping as soon as it includes the second one */
+    auto includes = [&](int lhs, int rhs){
+      std::size_t missing = nodes[rhs]->size();
+      const StateSet& wanted = *nodes[rhs];
+
+      /* a state in no rule is only reached if it is there from the start */
+      for(int node : wanted){
+        if(occurrences[node].empty() && !nodes[lhs]->contains(node)){
+          return false;
+        }
+      }
+
+      auto add = [&](int node){
+        if(!saturated[node]){
+          saturated[node] = true;
+          reached.push_back(node);
+          if(wanted.contains(node)){
+            missing--;
+          }
+        }
+      };
+      for(int node : *nodes[lhs]){
+        add(node);
+      }
+      for(int side : unconditional){
+        for(int node : *nodes[side % 2 == 0 ? rules[side / 2].second : rules[side / 2].first]){
+          add(node);
+        }
+      }
+      for(std::size_t i = 0; i < reached.size() && missing > 0; i++){
+        for(int side : occurrences[reached[i]]){
+          if(counters[side]++ == 0){
+            touched.push_back(side);
+          }
+          int from = side % 2 == 0 ? rules[side / 2].first : rules[side / 2].second;
+          if(counters[side] == (int)nodes[from]->size()){
+            int to = side % 2 == 0 ? rules[side / 2].second : rules[side / 2].first;
+            for(int node : *nodes[to]){
+              add(node);
+            }
+          }
+        }
+      }
+      for(int node : reached){
+        saturated[node] = false;
+      }
+      for(int side : touched){
+        counters[side] = 0;
+      }
+      reached.clear();
+      touched.clear();
+      return missing == 0;
+    };
+
+    /* the pairs are kept with the letter leading to them, to rebuild the word */
+    struct Pair{
+      int lhs, rhs;
+      int parent;
+      char letter;
+    };
+    std::vector<Pair> pairs;
+
+    StateSet lhsInitial(scratch.get()), rhsInitial(scratch.get());
+    for(std::size_t i = 0; i < offset; i++){
+      if(this->states[i].initial && !this->isRemoved(i)){
+        lhsInitial.insert(i);
+      }
+    }
+    for(std::size_t i = offset; i < n; i++){
+      if(other.states[i - offset].initial && !other.isRemoved(i - offset)){
+        rhsInitial.insert(i);
+      }
+    }
+    pairs.push_back(Pair{insert(lhsInitial), insert(rhsInitial), -1, fa::Epsilon});
+
+    std::queue<int> todo;
+    todo.push(0);
+    while(!todo.empty()){
+      int current = todo.front();
+      todo.pop();
+      int lhs = pairs[current].lhs;
+      int rhs = pairs[current].rhs;
+      if(find(lhs) == find(rhs) || (!rules.empty() && includes(lhs, rhs) && includes(rhs, lhs))){
+        continue;
+      }
+
+      if(finals[lhs] != finals[rhs]){
+        word.clear();
+        for(int p = current; pairs[p].parent != -1; p = pairs[p].parent){
+          word.push_back(pairs[p].letter);
+        }
+        std::reverse(word.begin(), word.end());
+        return false;
+      }
+
+      classes[find(lhs)] = find(rhs);
+      for(int id : {lhs, rhs}){
+        if(delta[id * m] == -1){
+          computeSuccessors(id);
+        }
+      }
+      for(std::size_t l = 0; l < m; l++){
+        pairs.push_back(Pair{delta[lhs * m + l], delta[rhs * m + l], current, letters[l]});
+        todo.push(pairs.size() - 1);
+      }
+
+      int rule = rules.size();
+      rules.emplace_back(lhs, rhs);
+      counters.resize(2 * rules.size(), 0);
+      for(int side : {0, 1}){
+        const StateSet& states = *nodes[side == 0 ? lhs : rhs];
+        if(states.empty()){
+          unconditional.push_back(2 * rule + side);
+        }
+        for(int node : states){
+          occurrences[node].push_back(2 * rule + side);
+        }
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief find a shortest word accepted by the automate, with a breadth-first search
+   * from the initial states keeping the transition leading to every state.
+   *
+   * @return std::optional<std::string> nothing if the language is empty
+   */
+  std::optional<std::string> Automaton::shortestAcceptedWord() const{
+    assert(this->isValid());
+
+    if(this->hasEpsilonTransition()){
+      return createWithoutEpsilon(*this).shortestAcceptedWord();
+    }
+
+    std::vector<int> parents(states.size(), -2);    // -2 if not reached yet, -1 for an initial state
+    std::vector<char> letters(states.size(), fa::Epsilon);
+    std::queue<int> todo;
+    for(std::size_t i = 0; i < states.size(); i++){
+      if(states[i].initial){
+        parents[i] = -1;
+        todo.push(i);
+      }
+    }
+
+    while(!todo.empty()){
+      int current = todo.front();
+      todo.pop();
+      if(states[current].final){
+        std::string word;
+        for(int node = current; parents[node] != -1; node = parents[node]){
+          word.push_back(letters[node]);
+        }
+        std::reverse(word.begin(), word.end());
+        return word;
+      }
+      for(auto const &link : (*edges)[current]){
+        if(parents[link.target] == -2){
+          parents[link.target] = current;
+          letters[link.target] = link.letter;
+          todo.push(link.target);
+        }
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  /**
+   * @brief find a shortest word accepted by both automata, with a breadth-first search
+   * over the pairs of states, the product being never built.
+   *
+   * @param other the other automate
+   * @return std::optional<std::string> nothing if no word is accepted by both
+   */
+  std::optional<std::string> Automaton::shortestCommonWord(const Automaton& other) const{
+    assert(this->isValid());
+    assert(other.isValid());
+
+    if(this->hasEpsilonTransition()){
+      return createWithoutEpsilon(*this).shortestCommonWord(other);
+    }
+    if(other.hasEpsilonTransition()){
+      return this->shortestCommonWord(createWithoutEpsilon(other));
+    }
+
+    /* the pairs are kept with the letter leading to them, to rebuild the word */
+    struct Pair{
+      int lhs, rhs;
+      int parent;
+      char letter;
+    };
+    std::vector<Pair> pairs;
+    std::unordered_map<std::uint64_t, int> known;
+    auto insert = [&](int lhs, int rhs, int parent, char letter){
+      if(known.emplace(std::uint64_t(lhs) << 32 | std::uint32_t(rhs), pairs.size()).second){
+        pairs.push_back(Pair{lhs, rhs, parent, letter});
+      }
+    };
+    for(std::size_t i = 0; i < this->states.size(); i++){
+      if(this->states[i].initial){
+        for(std::size_t j = 0; j < other.states.size(); j++){
+          if(other.states[j].initial){
+            insert(i, j, -1, fa::Epsilon);
+          }
+        }
+      }
+    }
+
+    /* the pairs are stored in the order of the search */
+    for(std::size_t current = 0; current < pairs.size(); current++){
+      const int lhs = pairs[current].lhs;
+      const int rhs = pairs[current].rhs;
+      if(this->states[lhs].final && other.states[rhs].final){
+        std::string word;
+        for(int p = current; pairs[p].parent != -1; p = pairs[p].parent){
+          word.push_back(pairs[p].letter);
+        }
+        std::reverse(word.begin(), word.end());
+        return word;
+      }
+
+      /* both lists of transitions are sorted by letter */
+      auto const &lhsLinks = (*this->edges)[lhs];
+      auto const &rhsLinks = (*other.edges)[rhs];
+      auto it_lhs = lhsLinks.begin();
+      auto it_rhs = rhsLinks.begin();
+      while(it_lhs != lhsLinks.end() && it_rhs != rhsLinks.end()){
+        if(it_lhs->letter < it_rhs->letter){
+          it_lhs++;
+        }else if(it_rhs->letter < it_lhs->letter){
+          it_rhs++;
+        }else{
+          const char letter = it_lhs->letter;
+          auto end_rhs = it_rhs;
+          for(; it_lhs != lhsLinks.end() && it_lhs->letter == letter; it_lhs++){
+            for(end_rhs = it_rhs; end_rhs != rhsLinks.end() && end_rhs->letter == letter; end_rhs++){
+              insert(it_lhs->target, end_rhs->target, current, letter);
+            }
+          }
+          it_rhs = end_rhs;
+        }
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  /**
+   * @brief find a shortest word accepted by the automate and rejected by the other one, with a
+   * breadth-first search over the pairs of a state and a subset of the other automate, the
+   * subsets being determinized on the fly.
+   *
+   * @param other the other automate
+   * @return std::optional<std::string> nothing if the language is included in the other one
+   */
+  std::optional<std::string> Automaton::shortestDifferenceWord(const Automaton& other) const{
+    assert(this->isValid());
+    assert(other.isValid());
+
+    if(this->hasEpsilonTransition()){
+      return createWithoutEpsilon(*this).shortestDifferenceWord(other);
+    }
+    if(other.hasEpsilonTransition()){
+      return this->shortestDifferenceWord(createWithoutEpsilon(other));
+    }
+
+    const std::vector<char> letters(alphabet.begin(), alphabet.end());
+    const std::size_t m = letters.size();
+    std::array<int, 256> letterIndex;
+    letterIndex.fill(-1);
+    for(std::size_t l = 0; l < m; l++){
+      letterIndex[(unsigned char)letters[l]] = l;
+    }
+
+    /* every subset of the other automate met has an id and, once needed, its successors */
+    SubsetTable subsets(1, std::pmr::get_default_resource());
+    std::vector<const StateSet*> nodes;
+    std::vector<bool> finals;
+    std::vector<int> delta;   // id * m + letter -> target, -1 if not computed yet
+    auto insertSubset = [&](const StateSet& subset){
+      auto rtn = subsets.insert(subset);
+      if(std::get<2>(rtn)){
+        nodes.push_back(std::get<1>(rtn));
+        finals.push_back(std::any_of(subset.begin(), subset.end(), [&](int node){
+          return other.states[node].final;
+        }));
+        delta.resize(delta.size() + m, -1);
+      }
+      return std::get<0>(rtn);
+    };
+    std::vector<std::vector<int>> targets(m);
+    StateSet subset;
+    auto computeSuccessors = [&](int id){
+      for(int node : *nodes[id]){
+        for(auto const &link : (*other.edges)[node]){
+          if(letterIndex[(unsigned char)link.letter] != -1){
+            targets[letterIndex[(unsigned char)link.letter]].push_back(link.target);
+          }
+        }
+      }
+      for(std::size_t l = 0; l < m; l++){
+        std::sort(targets[l].begin(), targets[l].end());
+        targets[l].erase(std::unique(targets[l].begin(), targets[l].end()), targets[l].end());
+        subset.assign(targets[l].data(), targets[l].data() + targets[l].size());
+        targets[l].clear();
+        int target = insertSubset(subset);
+        delta[id * m + l] = target;
+      }
+    };
+
+    /* the pairs are kept with the letter leading to them, to rebuild the word */
+    struct Pair{
+      int state, subset;
+      int parent;
+      char letter;
+    };
+    std::vector<Pair> pairs;
+    std::unordered_map<std::uint64_t, int> known;
+    auto insert = [&](int state, int subset, int parent, char letter){
+      if(known.emplace(std::uint64_t(state) << 32 | std::uint32_t(subset), pairs.size()).second){
+        pairs.push_back(Pair{state, subset, parent, letter});
+      }
+    };
+
+    for(std::size_t j = 0; j < other.states.size(); j++){
+      if(other.states[j].initial){
+        subset.insert(j);
+      }
+    }
+    const int initial = insertSubset(subset);
+    for(std::size_t i = 0; i < states.size(); i++){
+      if(states[i].initial){
+        insert(i, initial, -1, fa::Epsilon);
+      }
+    }
+
+    /* the pairs are stored in the order of the search */
+    for(std::size_t current = 0; current < pairs.size(); current++){
+      const int state = pairs[current].state;
+      const int id = pairs[current].subset;
+      if(states[state].final && !finals[id]){
+        std::string word;
+        for(int p = current; pairs[p].parent != -1; p = pairs[p].parent){
+          word.push_back(pairs[p].letter);
+        }
+        std::reverse(word.begin(), word.end());
+        return word;
+      }
+
+      if(delta[id * m] == -1){
+        computeSuccessors(id);
+      }
+      for(auto const &link : (*edges)[state]){
+        insert(link.target, delta[id * m + letterIndex[(unsigned char)link.letter]], current, link.letter);
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  /**
+   * @brief add two counts, saturating at UINT64_MAX.
+   *
+   * @param lhs the first count
+   * @param rhs the second count
+   * @return std::uint64_t
+   */
+  static std::uint64_t addSaturated(std::uint64_t lhs, std::uint64_t rhs){
+    std::uint64_t result;
+    return __builtin_add_overflow(lhs, rhs, &result) ? UINT64_MAX : result;
+  }
+
+  /**
+   * @brief multiply two counts, saturating at UINT64_MAX.
+   *
+   * @param lhs the first count
+   * @param rhs the second count
+   * @return std::uint64_t
+   */
+  static std::uint64_t multiplySaturated(std::uint64_t lhs, std::uint64_t rhs){
+    std::uint64_t result;
+    return __builtin_mul_overflow(lhs, rhs, &result) ? UINT64_MAX : result;
+  }
+
+  /**
+   * @brief count the words of a given length accepted by the automate. On a deterministic
+   * automate, the words accepted from a state are counted length after length backward from
+   * the final states, in O(length * (n + m)). When squaring the matrix of the transitions is
+   * cheaper, in O(n^3 log(length)), the counts are its power applied to the final states.
+   *
+   * @param length the length of the words
+   * @return std::uint64_t the number of words, UINT64_MAX if it does not fit
+   */
+  std::uint64_t Automaton::countWords(std::size_t length) const{
+    assert(this->isValid());
+
+    if(!this->isDeterministic()){
+      return createDeterministic(*this).countWords(length);
+    }
+
+    const std::size_t n = states.size();
+    std::vector<std::uint64_t> counts(n);   // state -> words accepted from it
+    for(std::size_t i = 0; i < n; i++){
+      counts[i] = states[i].final;
+    }
+
+    std::size_t rounds = 0;
+    for(std::size_t remaining = length; remaining > 0; remaining >>= 1){
+      rounds++;
+    }
+    const double dynamicCost = double(length) * (n + transitionCount);
+    const double matrixCost = double(n) * n * n * rounds;
+    if(dynamicCost <= matrixCost){
+      std::vector<std::uint64_t> next(n);
+      for(std::size_t k = 0; k < length; k++){
+        for(std::size_t i = 0; i < n; i++){
+          std::uint64_t count = 0;
+          for(auto const &link : (*edges)[i]){
+            count = addSaturated(count, counts[link.target]);
+          }
+          next[i] = count;
+        }
+        counts.swap(next);
+      }
+    }else{
+      /* the power of the matrix is applied to the counts bit after bit of the length */
+      std::vector<std::uint64_t> matrix(n * n, 0), square(n * n), next(n);
+      for(std::size_t i = 0; i < n; i++){
+        for(auto const &link : (*edges)[i]){
+          matrix[i * n + link.target]++;
+        }
+      }
+      for(std::size_t remaining = length; remaining > 0; remaining >>= 1){
+        if(remaining & 1){
+          for(std::size_t i = 0; i < n; i++){
+            std::uint64_t count = 0;
+            for(std::size_t j = 0; j < n; j++){
+              count = addSaturated(count, multiplySaturated(matrix[i * n + j], counts[j]));
+            }
+            next[i] = count;
+          }
+          counts.swap(next);
+        }
+        if(remaining > 1){
+          std::fill(square.begin(), square.end(), 0);
+          for(std::size_t i = 0; i < n; i++){
+            for(std::size_t k = 0; k < n; k++){
+              if(matrix[i * n + k] == 0){
+                continue;
+              }
+              for(std::size_t j = 0; j < n; j++){
+                square[i * n + j] = addSaturated(square[i * n + j], multiplySaturated(matrix[i * n + k], matrix[k * n + j]));
+              }
+            }
+          }
+          matrix.swap(square);
+        }
+      }
+    }
+
+    for(std::size_t i = 0; i < n; i++){
+      if(states[i].initial){
+        return counts[i];
+      }
+    }
+    return 0;
+  }
+
+  /**
+   * @brief run a work over [0, count) split into one contiguous block per worker.
+   *
+   * @param workers the number of threads, the first block runs in the calling thread
+   * @param count the number of items
+   * @param work the work to do on a block (worker, begin, end)
+   */
+  static void runInParallel(unsigned workers, std::size_t count, const std::function<void(unsigned, std::size_t, std::size_t)>& work){
+    std::vector<std::thread> pool;
+    for(unsigned worker = 1; worker < workers; worker++){
+      pool.emplace_back(work, worker, count * worker / workers, count * (worker + 1) / workers);
+    }
+    work(0, 0, count / workers);
+    for(auto &thread : pool){
+      thread.join();
+    }
+  }
+
+  /**
+   * @brief create the minimal version of the automate using the Moore algorithm.
+   * At every round, the signature of a state (its class and the classes of its targets)
+   * is hashed by blocks of states in parallel; the states are then dispatched by hash
+   * to the threads, which split the classes independently.
+   *
+   * @param automaton the automate
+   * @param threads the number of threads (0 for one per core)
+   * @return Automaton
+   */
+  Automaton Automaton::createMinimalMoore(const Automaton& automaton, unsigned threads){
+    Stats stats;
+    return createMinimalMoore(automaton, threads, stats);
+  }
+
+  /**
+   * @brief create the minimal version of the automate using the Moore algorithm,
+   * recording the work done.
+   *
+   * @param automaton the automate
+   * @param threads the number of threads (0 for one per core)
+   * @param stats the counters
+   * @return Automaton
+   */
+  Automaton Automaton::createMinimalMoore(const Automaton& automaton, unsigned threads, Stats& stats){
+    return createMinimalMoore(automaton, threads, stats, std::pmr::get_default_resource());
+  }
+
+  /**
+   * @brief create the minimal version of the automate using the Moore algorithm,
+   * the temporary structures drawn from the given memory resource.
+   *
+   * @param automaton the automate
+   * @param threads the number of threads (0 for one per core)
+   * @param resource the memory of the temporary structures, thread-safe if several threads
+   * @return Automaton
+   */
+  Automaton Automaton::createMinimalMoore(const Automaton& automaton, unsigned threads, std::pmr::memory_resource* resource){
+    Stats stats;
+    return createMinimalMoore(automaton, threads, stats, resource);
+  }
+
+  /**
+   * @brief create the minimal version of the automate using the Moore algorithm,
+   * recording the work done. The classes of every round are split with maps whose
+   * nodes come from a pool per shard, so they are reused from a round to the next.
+   *
+   * @param automaton the automate
+   * @param threads the number of threads (0 for one per core)
+   * @param stats the counters
+   * @param resource the memory of the temporary structures
+   * @return Automaton
+   */
+  Automaton Automaton::createMinimalMoore(const Automaton& automaton, unsigned threads, Stats& stats, std::pmr::memory_resource* resource){
+    assert(automaton.isValid());
+
+    if(threads == 0){
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    /* create a deterministic finite automaton (DFA) of the original automaton */
+    fa::Automaton dfa = *fa::Automaton::createDeterministic(automaton, threads, stats, Budget(), resource);
+    dfa.complete();
+    dfa.removeNonAccessibleStates();
+
+    Scratch scratch(resource);
+    FA_STATS(std::optional<PhaseScope> phase(std::in_place, stats, "refinement", scratch));
+
+    /* the DFA is complete, so the transitions of a state are one per letter in order */
+    const std::size_t n = dfa.states.size();
+    const std::size_t m = dfa.alphabet.size();
+    std::pmr::vector<int> delta(n * m, scratch.get());
+    for(std::size_t from = 0; from < n; from++){
+      assert((*dfa.edges)[from].size() == m);
+      for(std::size_t l = 0; l < m; l++){
+        delta[from * m + l] = (*dfa.edges)[from][l].target;
+      }
+    }
+
+    /* initialize the nodes*/
+    std::pmr::vector<int> moore(n, scratch.get()), mooreBis(n, scratch.get()); //array to store the number of an original node with a new node
+    std::size_t classes = 0;
+    for(std::size_t from = 0; from < n; from++){
+      if(dfa.states[from].final){
+        moore[from] = 1;  //final nodes
+      }else{
+        moore[from] = 0;  //other nodes
+      }
+    }
+
+    /* the signatures are compared through their hash, then through the classes */
+    std::pmr::vector<std::size_t> signature(n, scratch.get());
+    auto hash = [&](int from){
+      return signature[from];
+    };
+    auto equal = [&](int lhs, int rhs){
+      if(moore[lhs] != moore[rhs]){
+        return false;
+      }
+      for(std::size_t l = 0; l < m; l++){
+        if(moore[delta[lhs * m + l]] != moore[delta[rhs * m + l]]){
+          return false;
+        }
+      }
+      return true;
+    };
+
+    /* every thread dispatches the states in its own arena, every shard splits in its own pool */
+    const unsigned workers = std::max<std::size_t>(1, std::min<std::size_t>(threads, n / 1024));
+    using Classes = std::pmr::unordered_map<int, int, decltype(hash), decltype(equal)>;
+    std::vector<std::unique_ptr<std::pmr::monotonic_buffer_resource>> arenas;
+    std::vector<std::unique_ptr<std::pmr::unsynchronized_pool_resource>> pools;
+    std::vector<std::pmr::vector<std::pmr::vector<int>>> shards;
+    std::vector<Classes> known;
+    for(unsigned worker = 0; worker < workers; worker++){
+      arenas.push_back(std::make_unique<std::pmr::monotonic_buffer_resource>(scratch.upstream()));
+      pools.push_back(std::make_unique<std::pmr::unsynchronized_pool_resource>(scratch.upstream()));
+      shards.emplace_back(workers, arenas.back().get());
+      known.emplace_back(16, hash, equal, pools.back().get());
+    }
+    std::pmr::vector<int> counts(workers, scratch.get()), offsets(workers, scratch.get());
+    while(true){
+      /* hash the signature of every state and dispatch the state to a shard */
+      runInParallel(workers, n, [&](unsigned worker, std::size_t begin, std::size_t end){
+        for(auto &shard : shards[worker]){
+          shard.clear();
+        }
+        for(std::size_t from = begin; from < end; from++){
+          std::size_t h = combineHash(0, moore[from]);
+          for(std::size_t l = 0; l < m; l++){
+            h = combineHash(h, moore[delta[from * m + l]]);
+          }
+          signature[from] = h;
+          shards[worker][h % workers].push_back(from);
+        }
+      });
+
+      /* split the classes, each shard numbers its own classes */
+      runInParallel(workers, workers, [&](unsigned, std::size_t begin, std::size_t end){
+        for(std::size_t shard = begin; shard < end; shard++){
+          Classes& classes = known[shard];
+          classes.clear();
+          for(unsigned worker = 0; worker < workers; worker++){
+            for(int from : shards[worker][shard]){
+              auto it = classes.insert({from, (int)classes.size()}).first;
+              mooreBis[from] = it->second;
+            }
+          }
+          counts[shard] = classes.size();
+        }
+      });
+
+      /* give every shard its own range of classes */
+      std::size_t total = 0;
+      for(unsigned shard = 0; shard < workers; shard++){
+        offsets[shard] = total;
+        total += counts[shard];
+      }
+      if(workers > 1){
+        runInParallel(workers, n, [&](unsigned, std::size_t begin, std::size_t end){
+          for(std::size_t from = begin; from < end; from++){
+            mooreBis[from] += offsets[signature[from] % workers];
+          }
+        });
+      }
+
+      moore.swap(mooreBis);
+      FA_STATS(stats.refinementRounds++);
+      FA_STATS(reportProgress(stats, n, n * m));
+      if(total == classes){
+        break;
+      }
+      classes = total;
+    }
+
+    FA_STATS(phase.emplace(stats, "quotient", scratch));
+
+    /* number the classes from 1 in the order of their first state */
+    std::pmr::vector<int> renumber(classes, 0, scratch.get());
+    std::pmr::vector<int> representative(scratch.get());
+    for(std::size_t from = 0; from < n; from++){
+      if(renumber[moore[from]] == 0){
+        representative.push_back(from);
+        renumber[moore[from]] = representative.size();
+      }
+    }
+
+    /* create the minimal of DFA and initialize the alphabet */
+    fa::Automaton minimal;
+    minimal.alphabet = dfa.alphabet;
+
+    /* set the nodes, the index of a class is its number minus one */
+    for(std::size_t c = 0; c < representative.size(); c++){
+      minimal.addState(c + 1);
+      minimal.states[c].final = dfa.states[representative[c]].final;
+    }
+    for(std::size_t from = 0; from < n; from++){
+      if(dfa.states[from].initial){
+        minimal.states[renumber[moore[from]] - 1].initial = true;
+      }
+    }
+
+    /*set the transitions */
+    for(std::size_t c = 0; c < representative.size(); c++){
+      for(auto const &link : (*dfa.edges)[representative[c]]){
+        minimal.addLink(c, link.letter, renumber[moore[link.target]] - 1);
+      }
+    }
+
+    return minimal;
+  }
+
+  /**
+   * @brief create the minimal version of the automate using the Brzozowski algorithm
+   *
+   * @param automaton the automate
+   * @return Automaton
+   */
+  Automaton Automaton::createMinimalBrzozowski(const Automaton& automaton){
+    Stats stats;
+    return createMinimalBrzozowski(automaton, stats);
+  }
+
+  /**
+   * @brief create the minimal version of the automate using the Brzozowski algorithm,
+   * recording the work done by the two subset constructions.
+   *
+   * @param automaton the automate
+   * @param stats the counters
+   * @return Automaton
+   */
+  Automaton Automaton::createMinimalBrzozowski(const Automaton& automaton, Stats& stats){
+    return *createMinimalBrzozowski(automaton, stats, Budget());
+  }
+
+  /**
+   * @brief create the minimal version of the automate using the Brzozowski algorithm,
+   * unless the budget is exceeded.
+   *
+   * @param automaton the automate
+   * @param budget the limits
+   * @return std::optional<Automaton> nothing if the budget is exceeded
+   */
+  std::optional<Automaton> Automaton::createMinimalBrzozowski(const Automaton& automaton, const Budget& budget){
+    Stats stats;
+    return createMinimalBrzozowski(automaton, stats, budget);
+  }
+
+  /**
+   * @brief create the minimal version of the automate using the Brzozowski algorithm,
+   * recording the work done, unless the budget is exceeded.
+   *
+   * @param automaton the automate
+   * @param stats the counters
+   * @param budget the limits
+   * @return std::optional<Automaton> nothing if the budget is exceeded
+   */
+  std::optional<Automaton> Automaton::createMinimalBrzozowski(const Automaton& automaton, Stats& stats, const Budget& budget){
+    assert(automaton.isValid());
+
+    /* the mirrors are determinized directly, without being built */
+    std::optional<fa::Automaton> deterministicMirror = createSubsets(automaton, true, 1, stats, budget, std::pmr::get_default_resource());
+    if(!deterministicMirror){
+      return std::nullopt;
+    }
+    std::optional<fa::Automaton> minimal = createSubsets(*deterministicMirror, true, 1, stats, budget, std::pmr::get_default_resource());
+    if(!minimal){
+      return std::nullopt;
+    }
+
+    /* the complete automaton has at most one more state, with a transition per letter */
+    std::size_t states = minimal->countStates() + 1;
+    if(budget.isExceeded(states, states * minimal->countSymbols())){
+      return std::nullopt;
+    }
+    minimal->complete();
+    return minimal;
+  }
+
+
+
+  /**
+   * @brief create a smaller automate with the same language, without determinizing it.
+   * The states simulating each other are merged, and the transitions to a state simulated by
+   * another target of the same letter are removed. The backward simulation is the forward one
+   * of the mirror. The automate of an empty language is reduced to a single initial state.
+   *
+   * @param automaton the automate
+   * @param backward true to reduce with the backward simulation too
+   * @return Automaton
+   */
+  Automaton Automaton::createReducedBySimulation(const Automaton& automaton, bool backward){
+    assert(automaton.isValid());
+
+    /* an empty language keeps one initial state, over the same alphabet */
+    if(automaton.isLanguageEmpty()){
+      Automaton empty;
+      empty.alphabet = automaton.alphabet;
+      empty.addState(0);
+      empty.setStateInitial(0);
+      return empty;
+    }
+
+    Automaton reduced = createWithoutEpsilon(automaton);
+    reduced.removeNonAccessibleStates();
+    reduced.removeNonCoAccessibleStates();
+    reduced.reduceBySimulation();
+    if(backward){
+      reduced.mirror();
+      reduced.reduceBySimulation();
+      reduced.mirror();
+    }
+    return reduced;
+  }
+
+  /**
+   * @brief compute the maximal forward simulation with the algorithm of Henzinger, Henzinger
+   * and Kopke. A pair (p, q), q simulating p, is removed when p has a transition that q cannot
+   * follow. For every group of transitions of q with a letter and every state p', a counter holds
+   * the number of targets of the group simulating p'; when it falls to zero, the predecessors of
+   * p' with this letter are not simulated by q anymore.
+   *
+   * @return std::vector<std::uint64_t> the bit q of the row p is set if q simulates p
+   */
+  std::vector<std::uint64_t> Automaton::computeSimulation() const{
+    const std::size_t n = states.size();
+    const std::size_t words = (n + 63) / 64;
+    std::vector<std::uint64_t> relation(n * words, 0);
+    auto isSimulated = [&](std::size_t p, std::size_t q){
+      return relation[p * words + q / 64] >> (q % 64) & 1;
+    };
+
+    /* the transitions of a state with a same letter form a group */
+    std::vector<std::size_t> groupBegin(n + 1);     // state -> first group
+    std::vector<char> groupLetter;
+    std::vector<int> groupOwner;
+    for(std::size_t q = 0; q < n; q++){
+      groupBegin[q] = groupLetter.size();
+      auto const &links = (*edges)[q];
+      for(std::size_t j = 0; j < links.size(); j++){
+        if(j == 0 || links[j].letter != links[j - 1].letter){
+          groupLetter.push_back(links[j].letter);
+          groupOwner.push_back(q);
+        }
+      }
+    }
+    groupBegin[n] = groupLetter.size();
+    auto groupOf = [&](int q, char letter){
+      return std::lower_bound(groupLetter.begin() + groupBegin[q], groupLetter.begin() + groupBegin[q + 1], letter) - groupLetter.begin();
+    };
+
+    /* q can simulate p if it is final when p is, and has transitions with the letters of p */
+    for(std::size_t p = 0; p < n; p++){
+      for(std::size_t q = 0; q < n; q++){
+        if((!states[p].final || states[q].final) && std::includes(groupLetter.begin() + groupBegin[q], groupLetter.begin() + groupBegin[q + 1], groupLetter.begin() + groupBegin[p], groupLetter.begin() + groupBegin[p + 1])){
+          relation[p * words + q / 64] |= std::uint64_t(1) << (q % 64);
         }
       }
     }
 
+    /* the targets of every group simulating every state */
+    const std::size_t groups = groupLetter.size();
+    std::vector<std::uint32_t> counters(groups * n, 0);
+    for(std::size_t g = 0; g < groups; g++){
+      auto links = getLinks(groupOwner[g], groupLetter[g]);
+      for(auto link = links.first; link != links.second; ++link){
+        for(std::size_t p = 0; p < n; p++){
+          counters[g * n + p] += isSimulated(p, link->target);
+        }
+      }
+    }
+
+    /* remove the pairs (p, q) where p -a-> p' has no answer from q, the removed pairs being propagated */
+    const Predecessors& predecessors = getPredecessors();
+    auto predecessorsOf = [&](int node, char letter){
+      const Link* first = predecessors.links.data() + predecessors.begin[node];
+      const Link* last = predecessors.links.data() + predecessors.begin[node + 1];
+      return std::equal_range(first, last, Link{letter, 0}, [](const Link& lhs, const Link& rhs){
+        return lhs.letter < rhs.letter;
+      });
+    };
+    std::vector<std::pair<int, int>> removed;
+    auto refine = [&](std::size_t g, int node){
+      auto origins = predecessorsOf(node, groupLetter[g]);
+      const int q = groupOwner[g];
+      for(const Link* link = origins.first; link != origins.second; ++link){
+        if(isSimulated(link->target, q)){
+          relation[link->target * words + q / 64] &= ~(std::uint64_t(1) << (q % 64));
+          removed.emplace_back(link->target, q);
+        }
+      }
+    };
+    for(std::size_t g = 0; g < groups; g++){
+      for(std::size_t p = 0; p < n; p++){
+        if(counters[g * n + p] == 0){
+          refine(g, p);
+        }
+      }
+    }
+    while(!removed.empty()){
+      auto pair = removed.back();
+      removed.pop_back();
+      for(std::size_t i = predecessors.begin[pair.second]; i < predecessors.begin[pair.second + 1]; i++){
+        const Link& link = predecessors.links[i];
+        std::size_t g = groupOf(link.target, link.letter);
+        if(--counters[g * n + pair.first] == 0){
+          refine(g, pair.first);
+        }
+      }
+    }
+
+    return relation;
+  }
+
+  /**
+   * @brief merge the states simulating each other, then remove the transitions and the initial
+   * states made useless by a larger one.
+   */
+  void Automaton::reduceBySimulation(){
+    compact();
+    const std::size_t n = states.size();
+    const std::size_t words = (n + 63) / 64;
+    const std::vector<std::uint64_t> relation = computeSimulation();
+    auto isSimulated = [&](std::size_t p, std::size_t q){
+      return relation[p * words + q / 64] >> (q % 64) & 1;
+    };
+
+    /* a class of equivalent states is represented by its first state */
+    std::vector<int> classOf(n, -1);
+    std::vector<int> representatives;
+    for(std::size_t p = 0; p < n; p++){
+      if(classOf[p] != -1){
+        continue;
+      }
+      classOf[p] = representatives.size();
+      for(std::size_t q = p + 1; q < n; q++){
+        if(classOf[q] == -1 && isSimulated(p, q) && isSimulated(q, p)){
+          classOf[q] = representatives.size();
+        }
+      }
+      representatives.push_back(p);
+    }
+
+    /* keep the targets, or the initial classes, not simulated by another one */
+    auto isDominated = [&](int target, const std::vector<Link>& links, std::size_t first, std::size_t last){
+      for(std::size_t j = first; j < last; j++){
+        if(links[j].target != target && isSimulated(representatives[target], representatives[links[j].target])){
+          return true;
+        }
+      }
+      return false;
+    };
+
+    Automaton reduced;
+    reduced.alphabet = alphabet;
+    std::vector<Link> initials;
+    for(std::size_t c = 0; c < representatives.size(); c++){
+      reduced.addState(ids[representatives[c]]);
+      reduced.states[c].final = states[representatives[c]].final;
+    }
+    for(std::size_t p = 0; p < n; p++){
+      if(states[p].initial){
+        initials.push_back({fa::Epsilon, classOf[p]});
+      }
+    }
+    for(auto const &initial : initials){
+      if(!isDominated(initial.target, initials, 0, initials.size())){
+        reduced.states[initial.target].initial = true;
+      }
+    }
+
+    auto &table = reduced.writeEdges();
+    for(std::size_t p = 0; p < n; p++){
+      for(auto const &link : (*edges)[p]){
+        table[classOf[p]].push_back({link.letter, classOf[link.target]});
+      }
+    }
+    for(auto &links : table){
+      std::sort(links.begin(), links.end(), isLinkBefore);
+      links.erase(std::unique(links.begin(), links.end(), [](const Link& lhs, const Link& rhs){
+        return lhs.letter == rhs.letter && lhs.target == rhs.target;
+      }), links.end());
+
+      std::vector<Link> kept;
+      for(std::size_t first = 0, last; first < links.size(); first = last){
+        for(last = first; last < links.size() && links[last].letter == links[first].letter; last++){
+        }
+        for(std::size_t j = first; j < last; j++){
+          if(!isDominated(links[j].target, links, first, last)){
+            kept.push_back(links[j]);
+          }
+        }
+      }
+      links = std::move(kept);
+      reduced.transitionCount += links.size();
+    }
+
+    reduced.removeNonAccessibleStates();
+    *this = std::move(reduced);
+  }
+
+  /**
+   * @brief a partition of [0, n) refined by marking elements (Valmari and Lehtinen). The
+   * elements of a block are contiguous, and the marked ones are moved to its front.
+   */
+  class RefinablePartition{
+  public:
+    explicit RefinablePartition(std::size_t count)
+    : elements(count), locations(count), blocks(count, 0), first(1, 0), last(1, count), mid(1, 0){
+      for(std::size_t i = 0; i < count; i++){
+        elements[i] = i;
+        locations[i] = i;
+      }
+    }
+
+    int blockOf(int element) const{
+      return blocks[element];
+    }
+
+    std::size_t countElements(int block) const{
+      return last[block] - first[block];
+    }
+
+    const int* begin(int block) const{
+      return elements.data() + first[block];
+    }
+
+    const int* end(int block) const{
+      return elements.data() + last[block];
+    }
+
+    /**
+     * @brief mark an element, to split its block at the next split.
+     *
+     * @param element the element
+     */
+    void mark(int element){
+      int block = blocks[element];
+      std::size_t location = locations[element];
+      if(location < mid[block]){
+        return;
+      }
+      if(mid[block] == first[block]){
+        touched.push_back(block);
+      }
+      int other = elements[mid[block]];
+      elements[location] = other;
+      locations[other] = location;
+      elements[mid[block]] = element;
+      locations[element] = mid[block];
+      mid[block]++;
+    }
+
+    /**
+     * @brief split the blocks having marked and unmarked elements, the smaller part becoming
+     * a new block, then unmark every element.
+     *
+     * @param onSplit called with the old block and the new one
+     */
+    template<typename Callback>
+    void split(Callback onSplit){
+      for(int block : touched){
+        if(mid[block] == last[block]){
+          mid[block] = first[block];
+          continue;
+        }
+        int added = first.size();
+        if(mid[block] - first[block] <= last[block] - mid[block]){
+          first.push_back(first[block]);
+          last.push_back(mid[block]);
+          first[block] = mid[block];
+        }else{
+          first.push_back(mid[block]);
+          last.push_back(last[block]);
+          last[block] = mid[block];
+        }
+        mid.push_back(first[added]);
+        mid[block] = first[block];
+        for(std::size_t i = first[added]; i < last[added]; i++){
+          blocks[elements[i]] = added;
+        }
+        onSplit(block, added);
+      }
+      touched.clear();
+    }
+
+  private:
+    std::vector<int> elements;            // sorted by block
+    std::vector<std::size_t> locations;   // element -> position in elements
+    std::vector<int> blocks;              // element -> block
+    std::vector<std::size_t> first, last, mid;   // block -> its range, the marked elements before mid
+    std::vector<int> touched;             // the blocks with marked elements
+  };
+
+  /**
+   * @brief create the quotient of the automate by the coarsest forward bisimulation, with the
+   * algorithm of Paige and Tarjan. The blocks of states are grouped in compound blocks, and the
+   * blocks are stable with respect to them. While a compound block S holds several blocks, the
+   * smaller of two of them, B, is taken out and the blocks are split by the predecessors of B
+   * and by the predecessors of S - B, without visiting S - B: every transition leading into a
+   * compound block shares a counter with the transitions of its state with the same letter
+   * leading into the same compound block.
+   *
+   * @param automaton the automate
+   * @return Automaton
+   */
+  Automaton Automaton::createReducedByBisimulation(const Automaton& automaton){
+    assert(automaton.isValid());
+
+    Automaton nfa = createWithoutEpsilon(automaton);
+    nfa.compact();
+    const std::size_t n = nfa.states.size();
+    const Predecessors& predecessors = nfa.getPredecessors();
+
+    /* every block is in a compound block, the compounds holding several blocks are unstable */
+    RefinablePartition partition(n);
+    std::vector<int> compoundOf(1, 0);
+    std::vector<std::size_t> positions(1, 0);       // block -> position in its compound
+    std::vector<std::vector<int>> compounds(1, std::vector<int>(1, 0));
+    std::vector<int> unstable;
+    auto onSplit = [&](int block, int added){
+      int compound = compoundOf[block];
+      compoundOf.push_back(compound);
+      positions.push_back(compounds[compound].size());
+      compounds[compound].push_back(added);
+      if(compounds[compound].size() == 2){
+        unstable.push_back(compound);
+      }
+    };
+
+    /* the states are split by finality and by the letters they can read */
+    for(std::size_t i = 0; i < n; i++){
+      if(nfa.states[i].final){
+        partition.mark(i);
+      }
+    }
+    partition.split(onSplit);
+    for(char letter : nfa.alphabet){
+      for(std::size_t i = 0; i < n; i++){
+        auto links = nfa.getLinks(i, letter);
+        if(links.first != links.second){
+          partition.mark(i);
+        }
+      }
+      partition.split(onSplit);
+    }
+
+    /* a transition is a link of the predecessors, its counter first counts the transitions of its state with its letter */
+    std::vector<int> counterOf(predecessors.links.size());
+    std::vector<std::size_t> counters;
+    std::vector<int> groups(n, -1);     // state -> counter of the current letter
+    for(char letter : nfa.alphabet){
+      for(std::size_t y = 0; y < n; y++){
+        auto origins = std::equal_range(predecessors.links.begin() + predecessors.begin[y], predecessors.links.begin() + predecessors.begin[y + 1], Link{letter, 0}, [](const Link& lhs, const Link& rhs){
+          return lhs.letter < rhs.letter;
+        });
+        for(auto link = origins.first; link != origins.second; ++link){
+          if(groups[link->target] == -1){
+            groups[link->target] = counters.size();
+            counters.push_back(0);
+          }
+          counterOf[link - predecessors.links.begin()] = groups[link->target];
+          counters[groups[link->target]]++;
+        }
+      }
+      std::fill(groups.begin(), groups.end(), -1);
+    }
+
+    std::vector<int> transitions;         // the transitions leading into the splitter, by letter
+    std::vector<int> grouped;
+    std::vector<std::size_t> letterCounts(256, 0);   // letter -> its transitions, then its next position
+    std::vector<unsigned char> letters;   // the letters of the transitions leading into the splitter
+    std::vector<int> newCounters(n, -1);  // state -> counter of its transitions into the splitter
+    std::vector<int> oldCounters(n);      // state -> counter of its transitions into the compound
+    std::vector<int> sources;
+    while(!unstable.empty()){
+      int compound = unstable.back();
+      std::vector<int>& members = compounds[compound];
+      int splitter = partition.countElements(members[0]) <= partition.countElements(members[1]) ? members[0] : members[1];
+
+      /* the splitter becomes a compound block on its own */
+      members[positions[splitter]] = members.back();
+      positions[members.back()] = positions[splitter];
+      members.pop_back();
+      if(members.size() < 2){
+        unstable.pop_back();
+      }
+      compoundOf[splitter] = compounds.size();
+      positions[splitter] = 0;
+      compounds.emplace_back(1, splitter);
+
+      /* the transitions into the splitter are grouped by letter with a counting sort, in linear time */
+      transitions.clear();
+      letters.clear();
+      for(const int* y = partition.begin(splitter); y != partition.end(splitter); ++y){
+        for(std::size_t i = predecessors.begin[*y]; i < predecessors.begin[*y + 1]; i++){
+          unsigned char letter = predecessors.links[i].letter;
+          if(letterCounts[letter]++ == 0){
+            letters.push_back(letter);
+          }
+          transitions.push_back(i);
+        }
+      }
+      std::size_t offset = 0;
+      for(unsigned char letter : letters){
+        std::size_t count = letterCounts[letter];
+        letterCounts[letter] = offset;
+        offset += count;
+      }
+      grouped.resize(transitions.size());
+      for(int t : transitions){
+        grouped[letterCounts[static_cast<unsigned char>(predecessors.links[t].letter)]++] = t;
+      }
+      for(unsigned char letter : letters){
+        letterCounts[letter] = 0;
+      }
+      transitions.swap(grouped);
+
+      for(std::size_t begin = 0, end; begin < transitions.size(); begin = end){
+        const char letter = predecessors.links[transitions[begin]].letter;
+        for(end = begin; end < transitions.size() && predecessors.links[transitions[end]].letter == letter; end++){
+          int x = predecessors.links[transitions[end]].target;
+          if(newCounters[x] == -1){
+            newCounters[x] = counters.size();
+            counters.push_back(0);
+            oldCounters[x] = counterOf[transitions[end]];
+            sources.push_back(x);
+          }
+          counters[newCounters[x]]++;
+        }
+
+        /* split by the predecessors of the splitter, then by those having no transition to the rest of the compound */
+        for(int x : sources){
+          partition.mark(x);
+        }
+        partition.split(onSplit);
+        for(int x : sources){
+          if(counters[newCounters[x]] == counters[oldCounters[x]]){
+            partition.mark(x);
+          }
+        }
+        partition.split(onSplit);
+
+        for(std::size_t t = begin; t < end; t++){
+          int x = predecessors.links[transitions[t]].target;
+          counters[counterOf[transitions[t]]]--;
+          counterOf[transitions[t]] = newCounters[x];
+        }
+        for(int x : sources){
+          newCounters[x] = -1;
+        }
+        sources.clear();
+      }
+    }
+
+    /* the classes are numbered in the order of their first state, which gives its number */
+    std::vector<int> classOf(compoundOf.size(), -1);
+    Automaton reduced;
+    reduced.alphabet = nfa.alphabet;
+    for(std::size_t i = 0; i < n; i++){
+      int block = partition.blockOf(i);
+      if(classOf[block] == -1){
+        classOf[block] = reduced.states.size();
+        reduced.addState(nfa.ids[i]);
+        reduced.states[classOf[block]].final = nfa.states[i].final;
+      }
+      if(nfa.states[i].initial){
+        reduced.states[classOf[block]].initial = true;
+      }
+    }
+
+    auto &table = reduced.writeEdges();
+    for(std::size_t i = 0; i < n; i++){
+      for(auto const &link : (*nfa.edges)[i]){
+        table[classOf[partition.blockOf(i)]].push_back({link.letter, classOf[partition.blockOf(link.target)]});
+      }
+    }
+    for(auto &links : table){
+      std::sort(links.begin(), links.end(), isLinkBefore);
+      links.erase(std::unique(links.begin(), links.end(), [](const Link& lhs, const Link& rhs){
+        return lhs.letter == rhs.letter && lhs.target == rhs.target;
+      }), links.end());
+      reduced.transitionCount += links.size();
+    }
+
+    return reduced;
+  }
+
+  /**
+   * @brief remove the epsilon transitions of the automate
+   * Every state gets the transitions and the finality of its epsilon closure.
+   *
+   * @param automaton the automate
+   * @return Automaton
+   */
+  Automaton Automaton::createWithoutEpsilon(const Automaton& automaton){
+    fa::Automaton automaton_no_epsilon = automaton;
+    automaton_no_epsilon.removeEpsilon();
     return automaton_no_epsilon;
   }
-}
\ No newline at end of file
+
+  /**
+   * @brief create an automaton without epsilon transitions, reusing the given automate
+   *
+   * @param automaton the automate
+   * @return Automaton
+   */
+  Automaton Automaton::createWithoutEpsilon(Automaton&& automaton){
+    automaton.removeEpsilon();
+    return std::move(automaton);
+  }
+
+  /**
+   * @brief replace the epsilon transitions by the transitions of the epsilon closures
+   *
+   */
+  void Automaton::removeEpsilon(){
+    assert(isValid());
+
+    if(!hasEpsilonTransition()){
+      return;
+    }
+
+    /*
+     * a closure contains the closures of its states, so a state made final
+     * before its closure is read does not change the result
+     */
+    std::vector<std::vector<Link>> table(edges->size());
+    std::pmr::vector<bool> knownNodes(states.size(), false);
+    std::pmr::vector<int> closure;
+    transitionCount = 0;
+    for(std::size_t i = 0; i < states.size(); i++){
+      if(isRemoved(i)){
+        continue;
+      }
+      closure.clear();
+      researchEpsilonClosure(i, knownNodes, closure);
+      auto &links = table[i];
+      for(int node : closure){
+        knownNodes[node] = false;
+        if(states[node].final){
+          states[i].final = true;
+        }
+        for(auto const &link : (*edges)[node]){
+          if(link.letter != fa::Epsilon){
+            links.push_back(link);
+          }
+        }
+      }
+      std::sort(links.begin(), links.end(), isLinkBefore);
+      links.erase(std::unique(links.begin(), links.end(), [](const Link& lhs, const Link& rhs){
+        return lhs.letter == rhs.letter && lhs.target == rhs.target;
+      }), links.end());
+      transitionCount += links.size();
+    }
+    setEdges(std::move(table));
+  }
+}
@@ -2,6 +2,7 @@
 #define AUTOMATON_H
 
 #include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 #include <set>
 #include <string>
@@ -9,6 +10,7 @@
 
 #include <map>            // needed for the good working of std::map & std::multimap
 #include <vector>         // needed for the good working of std::vector
+#include <unordered_map>  // needed for the good working of std::unordered_map
 
 #include <algorithm>      // std::find
 #include <iostream>       // std::cout
@@ -17,6 +19,15 @@
 #include <optional>       // optional
 #include <climits>  // INT_MAX
 
+#include <atomic>         // std::atomic
+#include <chrono>         // std::chrono::nanoseconds
+#include <functional>     // std::function
+#include <memory>         // std::shared_ptr
+#include <memory_resource>  // std::pmr::memory_resource
+
+#include "Shared.h"       // fa::Shared
+#include "StateSet.h"     // fa::StateSet
+
 namespace fa {
   constexpr char Epsilon = '\0';
 
@@ -29,6 +40,73 @@ namespace fa {
     int target;
   };
 
+  /**
+   * A step of an algorithm, with its wall time and the allocations of its scratch memory
+   */
+  struct Phase{
+    std::string name;
+    std::chrono::nanoseconds time;
+    std::size_t allocations;
+    std::size_t bytes;
+  };
+
+  /**
+   * What the algorithms did, accumulated over the calls taking the same Stats.
+   *
+   * The counters are only filled when the library is built with FA_ENABLE_STATS,
+   * otherwise the instrumentation is compiled out and they stay at zero.
+   */
+  struct Stats{
+    std::size_t subsetsExplored = 0;    // subsets whose successors were computed
+    std::size_t refinementRounds = 0;   // rounds of the Moore algorithm
+    std::size_t productPairs = 0;       // pairs of states created by the products
+    std::size_t peakStates = 0;
+    std::size_t peakTransitions = 0;
+    std::vector<Phase> phases;
+
+    /**
+     * Called with the counters at every level, round or batch of pairs, if set
+     */
+    std::function<void(const Stats&)> progress;
+  };
+
+  /**
+   * Limits given to an operation that can explode, checked while it runs.
+   *
+   * The checks are regular but not continuous, so an operation can go a bit over
+   * its limits before giving up.
+   */
+  struct Budget{
+    std::size_t maxStates = SIZE_MAX;
+    std::size_t maxTransitions = SIZE_MAX;
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    const std::atomic<bool>* cancelled = nullptr;   // set to true by another thread to give up
+
+    /**
+     * Tell if an automaton of this size, or the time spent, is over the budget
+     */
+    bool isExceeded(std::size_t states, std::size_t transitions) const;
+  };
+
+  /**
+   * The shape of the code written by Automaton::generateSource
+   */
+  enum class SourceStyle{
+    Goto,     // a label per state, the letters read by a switch jumping to the next label
+    Switch    // a case per state in a loop over the letters
+  };
+
+  /**
+   * The transitions of an automaton copied into contiguous arrays, its states renumbered 0..n-1
+   */
+  struct Successors{
+    std::vector<std::size_t> begin;   // state -> first transition, n + 1 entries
+    std::vector<char> letters;        // transition -> letter, sorted by letter for every state
+    std::vector<int> targets;         // transition -> target
+    std::vector<bool> initials;       // state -> initial
+    std::vector<bool> finals;         // state -> final
+  };
+
   class Automaton {
   public:
     /**
@@ -94,6 +172,19 @@ namespace fa {
      */
     std::size_t countStates() const;
 
+    /**
+     * Renumber the internal indexes of the states after removals.
+     *
+     * The numbers of the states are kept, only the storage is compacted.
+     */
+    void compact();
+
+    /**
+     * Copy the transitions leaving every state, the states being renumbered 0..n-1
+     * in the order of their storage.
+     */
+    Successors getSuccessors() const;
+
     /**
      * Set the state initial.
      */
@@ -139,11 +230,28 @@ namespace fa {
      */
     std::size_t countTransitions() const;
 
+    /**
+     * Find the states having a transition with the letter to the state
+     *
+     * The predecessors of every state are indexed at the first call, and the index
+     * is kept until the transitions change.
+     */
+    StateSet predecessors(int state, char alpha) const;
+
     /**
      * Print the automaton in a friendly way
      */
     void prettyPrint(std::ostream& os) const;
 
+    /**
+     * Write a standalone C++ source defining 'bool function(std::string_view word)',
+     * which tells if the word is accepted by this deterministic automaton
+     *
+     * The states are coded directly instead of being rows of a table. The states
+     * from which no final state is reachable are left out and reject at once.
+     */
+    void generateSource(std::ostream& os, const std::string& function, SourceStyle style = SourceStyle::Goto) const;
+
     /**
      * Print the automaton with respect to the DOT specification
      */
@@ -174,11 +282,63 @@ namespace fa {
      */
     void removeNonCoAccessibleStates();
 
+    /**
+     * Make the automaton complete, if not already complete
+     */
+    void complete();
+
+    /**
+     * Make the automaton accept the complement of its language
+     */
+    void complement();
+
+    /**
+     * Make the automaton accept the mirror of its language
+     */
+    void mirror();
+
+    /**
+     * Remove the epsilon transitions, keeping the language
+     */
+    void removeEpsilon();
+
     /**
      * Check if the language of the automaton is empty
      */
     bool isLanguageEmpty() const;
 
+    /**
+     * Tell if the automaton accepts every word over its alphabet, without complementing it
+     *
+     * On failure, the second overload gives a shortest word that is rejected.
+     */
+    bool isUniversal() const;
+    bool isUniversal(std::string& word) const;
+
+    /**
+     * Find a shortest word accepted by the automaton, nothing if the language is empty
+     */
+    std::optional<std::string> shortestAcceptedWord() const;
+
+    /**
+     * Find a shortest word accepted by both automata, without building their product
+     */
+    std::optional<std::string> shortestCommonWord(const Automaton& other) const;
+
+    /**
+     * Find a shortest word accepted by the automaton and rejected by the other one,
+     * without complementing it
+     */
+    std::optional<std::string> shortestDifferenceWord(const Automaton& other) const;
+
+    /**
+     * Count the words of the given length accepted by the automaton, determinized if needed
+     *
+     * The count saturates at UINT64_MAX. A large length is handled by squaring the
+     * transition matrix, in a time logarithmic in the length.
+     */
+    std::uint64_t countWords(std::size_t length) const;
+
     /**
      * Tell if the intersection with another automaton is empty
      */
@@ -187,7 +347,7 @@ namespace fa {
     /**
      * Read the string and compute the state set after traversing the automaton
      */
-    std::set<int> readString(const std::string& word) const;
+    StateSet readString(const std::string& word) const;
 
     /**
      * Tell if the word is in the language accepted by the automaton
@@ -199,21 +359,56 @@ namespace fa {
      * language accepted by the other automaton
      */
     bool isIncludedIn(const Automaton& other) const;
+    bool isIncludedIn(const Automaton& other, Stats& stats) const;
+
+    /**
+     * Same as above, without result if the budget is exceeded
+     */
+    std::optional<bool> isIncludedIn(const Automaton& other, const Budget& budget) const;
+
+    /**
+     * Tell if the two automata accept the same language, without determinizing them
+     *
+     * On failure, the second overload gives a word accepted by only one of them.
+     */
+    bool isEquivalentTo(const Automaton& other) const;
+    bool isEquivalentTo(const Automaton& other, std::string& word) const;
 
     /**
      * Create a mirror automaton
      */
     static Automaton createMirror(const Automaton& automaton);
 
+    /**
+     * Same as above, reusing the storage of the given automaton
+     */
+    static Automaton createMirror(Automaton&& automaton);
+
     /**
      * Create a complete automaton, if not already complete
      */
     static Automaton createComplete(const Automaton& automaton);
 
+    /**
+     * Same as above, reusing the storage of the given automaton
+     */
+    static Automaton createComplete(Automaton&& automaton);
+
     /**
      * Create a complement automaton
      */
     static Automaton createComplement(const Automaton& automaton);
+    static Automaton createComplement(const Automaton& automaton, Stats& stats);
+
+    /**
+     * Same as above, without result if the budget is exceeded
+     */
+    static std::optional<Automaton> createComplement(const Automaton& automaton, const Budget& budget);
+
+    /**
+     * Same as above, reusing the storage of the given automaton
+     */
+    static Automaton createComplement(Automaton&& automaton);
 
     /**
      * Create the product of two automata
@@ -221,64 +416,177 @@ namespace fa {
      * The product of two automata accept the intersection of the two languages.
      */
     static Automaton createProduct(const Automaton& lhs, const Automaton& rhs);
+    static Automaton createProduct(const Automaton& lhs, const Automaton& rhs, Stats& stats);
 
     /**
      * Create a deterministic automaton, if not already deterministic
+     *
+     * The subsets of a same depth are explored by the given number of threads
+     * (0 for one per core). The result does not depend on the number of threads.
      */
-    static Automaton createDeterministic(const Automaton& other);
+    static Automaton createDeterministic(const Automaton& other, unsigned threads = 1);
+    static Automaton createDeterministic(const Automaton& other, unsigned threads, Stats& stats);
+
+    /**
+     * Same as above, without result if the budget is exceeded
+     */
+    static std::optional<Automaton> createDeterministic(const Automaton& other, const Budget& budget, unsigned threads = 1);
+
+    /**
+     * Same as above, the temporary structures drawn from the given memory resource,
+     * which must be thread-safe if several threads are used
+     */
+    static Automaton createDeterministic(const Automaton& other, unsigned threads, std::pmr::memory_resource* resource);
+
+    /**
+     * Same as above, reusing the storage of the given automaton if it is already deterministic
+     */
+    static Automaton createDeterministic(Automaton&& other, unsigned threads = 1);
 
     /**
      * Create an equivalent minimal automaton with the Moore algorithm
+     *
+     * The refinement rounds are shared between the given number of threads
+     * (0 for one per core). The result does not depend on the number of threads.
      */
-    static Automaton createMinimalMoore(const Automaton& other);
+    static Automaton createMinimalMoore(const Automaton& other, unsigned threads = 1);
+    static Automaton createMinimalMoore(const Automaton& other, unsigned threads, Stats& stats);
+
+    /**
+     * Same as above, the temporary structures drawn from the given memory resource,
+     * which must be thread-safe if several threads are used
+     */
+    static Automaton createMinimalMoore(const Automaton& other, unsigned threads, std::pmr::memory_resource* resource);
 
     /**
      * Create an equivalent minimal automaton with the Brzozowski algorithm
      */
     static Automaton createMinimalBrzozowski(const Automaton& other);
+    static Automaton createMinimalBrzozowski(const Automaton& other, Stats& stats);
+
+    /**
+     * Same as above, without result if the budget is exceeded
+     */
+    static std::optional<Automaton> createMinimalBrzozowski(const Automaton& other, const Budget& budget);
+
+    /**
+     * Create an equivalent automaton, still non-deterministic, reduced with the forward
+     * simulation and, if asked, with the backward simulation too
+     */
+    static Automaton createReducedBySimulation(const Automaton& other, bool backward = false);
+
+    /**
+     * Create the quotient of the automaton by the coarsest forward bisimulation, still
+     * non-deterministic, in O(m log n) time
+     */
+    static Automaton createReducedByBisimulation(const Automaton& other);
 
     /**
      * Create an equivalent automaton with the epsilon transition removed
      */
     static Automaton createWithoutEpsilon(const Automaton& automaton);
+
+    /**
+     * Same as above, reusing the storage of the given automaton
+     */
+    static Automaton createWithoutEpsilon(Automaton&& automaton);
   
   private:
+    /**
+     * Number stored at the index of a removed state, until the automaton is compacted
+     */
+    static constexpr int Removed = -1;
+
     /**
      * The structure of our automaton
+     *
+     * The states are stored at the dense indexes 0..n-1, the number given by the
+     * user is only used at the interface. The targets of the links are indexes.
+     * The transitions and the numbering are shared between the copies of an
+     * automaton until one of them changes them.
      */
     std::set<char> alphabet;
-    std::map<int, State> node;
-    std::multimap<int, Link> transition;
+    std::vector<int> ids;                           // index -> number of the state
+    std::vector<State> states;                      // index -> initial / final
+    Shared<std::vector<std::vector<Link>>> edges;   // index -> transitions sorted by letter then target
+    Shared<std::unordered_map<int, int>> index;     // number of the state -> index
+    std::size_t transitionCount;
+    int nextNumber;
 
     /**
-     * A better removeState that allows iteration (consider using it over removeState)
+     * The transitions arriving at every index, the target of a link being its origin
      */
-    std::optional<std::map<int, State>::iterator> betterRemoveState(int state);
-    
+    struct Predecessors{
+      std::vector<std::size_t> begin;   // index -> first link, n + 1 entries
+      std::vector<Link> links;          // sorted by letter then origin for every index
+    };
+    mutable std::shared_ptr<const Predecessors> predecessorIndex;   // built when needed, dropped when the transitions change
+
     /**
-     * A better removeTransition that allows iteration (consider using it over removeTransition)
+     * Give the transitions for a change, or replace them, dropping the predecessors
      */
-    std::optional<std::multimap<int, Link>::iterator> betterRemoveTransition(int from, char alpha, int to);
-    
+    std::vector<std::vector<Link>>& writeEdges();
+    void setEdges(std::vector<std::vector<Link>>&& table);
+
+    /**
+     * Give the predecessors of every index, indexed at the first call
+     */
+    const Predecessors& getPredecessors() const;
+
+    /**
+     * Find the index of a state, -1 if the state does not exist
+     */
+    int getIndex(int state) const;
+
+    /**
+     * Tell if the index is the one of a removed state
+     */
+    bool isRemoved(int actualNode) const;
+
+    /**
+     * Add a transition between two indexes, without checking the symbol
+     */
+    bool addLink(int from, char alpha, int to);
+
+    /**
+     * Find the transitions with the given letter leaving the index
+     */
+    std::pair<std::vector<Link>::const_iterator, std::vector<Link>::const_iterator> getLinks(int from, char alpha) const;
+
     /**
-     * Find all the nodes targetted by a specific transition from a specific node
+     * Remove the states not kept, then compact the automaton
      */
-    std::optional<std::set<int>> transitionBeginWith(int from, char alpha) const;
+    void removeStates(const std::vector<bool>& keptNodes);
 
     /**
      * Check if there is any Final State reachable from the node
      */
-    bool researchFinalStateInDepth(int actualNode, std::set<int>& knownNodes) const;
+    bool researchFinalStateInDepth(int actualNode, std::vector<bool>& knownNodes) const;
     
     /**
      * Store every node reachable from the node
      */    
-    void researchInDepth(int actualNode, std::set<int>& knownNodes) const;
+    void researchInDepth(int actualNode, std::vector<bool>& knownNodes) const;
  
      /**
      * Store every node that can reach the node
      */
-    void researchInSurface(int actualNode, std::set<int>& knownNodes) const;
+    void researchInSurface(int actualNode, std::vector<bool>& knownNodes) const;
+
+    /**
+     * Store every node reachable from the node with epsilon transitions only
+     */
+    void researchEpsilonClosure(int actualNode, std::pmr::vector<bool>& knownNodes, std::pmr::vector<int>& closure) const;
+
+    /**
+     * Compute the maximal forward simulation, as a bit matrix of n rows of (n + 63) / 64 words
+     */
+    std::vector<std::uint64_t> computeSimulation() const;
+
+    /**
+     * Quotient the automaton by the forward simulation and remove the transitions it makes useless
+     */
+    void reduceBySimulation();
 
     /**
      * Create the product of two alphabets
@@ -286,19 +594,34 @@ namespace fa {
     static std::set<char> createAlphabetProduct(const std::set<char>& lhs, const std::set<char>& rhs);
 
     /**
-     * Find the lowest number available for a new node
+     * Swap the final and the non-final states
+     */
+    void swapFinalStates();
+
+    /**
+     * Find a number available for a new node
      */
     int getNumberForNewNode() const;
 
     /**
-     * Find the last node when itering with a word
+     * Find the last nodes when itering with a word from the given nodes
      */
-    std::set<int> getLastNodesOfTheWord(int actualNode, const std::string& word) const;
-    
+    StateSet getLastNodesOfTheWord(const StateSet& actualNodes, const std::string& word) const;
+
+    /**
+     * The algorithms behind the public overloads, without result if the budget is exceeded
+     */
+    std::optional<bool> isIncludedIn(const Automaton& other, Stats& stats, const Budget& budget) const;
+    static std::optional<Automaton> createComplement(const Automaton& automaton, Stats& stats, const Budget& budget);
+    static std::optional<Automaton> createProduct(const Automaton& lhs, const Automaton& rhs, Stats& stats, const Budget& budget);
+    static std::optional<Automaton> createDeterministic(const Automaton& other, unsigned threads, Stats& stats, const Budget& budget, std::pmr::memory_resource* resource);
+    static Automaton createMinimalMoore(const Automaton& other, unsigned threads, Stats& stats, std::pmr::memory_resource* resource);
+    static std::optional<Automaton> createMinimalBrzozowski(const Automaton& other, Stats& stats, const Budget& budget);
+
     /**
-     * Remove the Epsilon Transition from an automaton
+     * The subset construction of the automaton, or of its mirror without building it
      */
-    void removeEpsilonTransition(int actualNode, std::set<int>& knownNodes);
+    static std::optional<Automaton> createSubsets(const Automaton& other, bool mirrored, unsigned threads, Stats& stats, const Budget& budget, std::pmr::memory_resource* resource);
   };
 }
 
@@ -0,0 +1,29 @@
+#ifndef BLOW_UP_H
+#define BLOW_UP_H
+
+#include "Automaton.h"    // fa::Automaton
+
+/**
+ * The NFA of (a|b)*a(a|b)^n, its deterministic version has 2^(n+1) states.
+ * It is shared by benchfa and by genfa, which generates its matcher at build time.
+ */
+inline fa::Automaton createBlowUp(int n){
+  fa::Automaton fa;
+  fa.addSymbol('a');
+  fa.addSymbol('b');
+  for(int i = 0; i <= n + 1; i++){
+    fa.addState(i);
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(n + 1);
+  fa.addTransition(0, 'a', 0);
+  fa.addTransition(0, 'b', 0);
+  fa.addTransition(0, 'a', 1);
+  for(int i = 1; i <= n; i++){
+    fa.addTransition(i, 'a', i + 1);
+    fa.addTransition(i, 'b', i + 1);
+  }
+  return fa;
+}
+
+#endif // BLOW_UP_H
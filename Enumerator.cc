@@ -0,0 +1,281 @@
+/**
+ * @file Enumerator.cc
+ * @author Pierre Viprey
+ * @brief Ordered enumeration of the words accepted by an automate
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ */
+#include "Enumerator.h"
+
+#include <cassert>
+
+namespace fa {
+  /**
+   * @brief get the current word.
+   *
+   * @return const std::string&
+   */
+  const std::string& WordEnumerator::Iterator::operator*() const{
+    return enumerator->getWord();
+  }
+
+  /**
+   * @brief get the current word.
+   *
+   * @return const std::string*
+   */
+  const std::string* WordEnumerator::Iterator::operator->() const{
+    return &enumerator->getWord();
+  }
+
+  /**
+   * @brief go to the next word, the iterator becoming the end once the words are exhausted.
+   *
+   * @return Iterator&
+   */
+  WordEnumerator::Iterator& WordEnumerator::Iterator::operator++(){
+    if(!enumerator->next()){
+      enumerator = nullptr;
+    }
+    return *this;
+  }
+
+  /**
+   * @brief prepare the enumeration. The automate is determinized if needed and trimmed, then its
+   * transitions are copied once, sorted by letter for every state. The language is finite if
+   * and only if the trimmed automate has no cycle, which is checked by removing the states
+   * without predecessor one after the other.
+   *
+   * @param automaton the automate
+   * @param order the order of the words, no word being given in lexicographic order for an
+   * infinite language
+   */
+  WordEnumerator::WordEnumerator(const Automaton& automaton, WordOrder order)
+  : order(order), states(0), initial(-1), finite(true), started(false), finished(false){
+    assert(automaton.isValid());
+
+    Automaton dfa = automaton.isDeterministic() ? automaton : Automaton::createDeterministic(automaton);
+    dfa.removeNonAccessibleStates();
+    dfa.removeNonCoAccessibleStates();
+    Successors successors = dfa.getSuccessors();
+    states = successors.finals.size();
+    first = std::move(successors.begin);
+    letters = std::move(successors.letters);
+    targets = std::move(successors.targets);
+    finals = std::move(successors.finals);
+
+    std::vector<std::size_t> incoming(states, 0);
+    for(std::size_t i = 0; i < states; i++){
+      for(std::size_t t = first[i]; t < first[i + 1]; t++){
+        incoming[targets[t]]++;
+      }
+      if(successors.initials[i]){
+        initial = i;
+      }
+    }
+
+    std::vector<int> pending;
+    for(std::size_t i = 0; i < states; i++){
+      if(incoming[i] == 0){
+        pending.push_back(i);
+      }
+    }
+    std::size_t removed = 0;
+    while(!pending.empty()){
+      int state = pending.back();
+      pending.pop_back();
+      removed++;
+      for(std::size_t t = first[state]; t < first[state + 1]; t++){
+        if(--incoming[targets[t]] == 0){
+          pending.push_back(targets[t]);
+        }
+      }
+    }
+    finite = removed == states;
+
+    /* an infinite language has no lexicographic enumeration: the words may have no first one */
+    finished = initial == -1 || (order == WordOrder::Lexicographic && !finite);
+  }
+
+  /**
+   * @brief go to the next word.
+   *
+   * @return true (success)
+   * @return false (every word has been given)
+   */
+  bool WordEnumerator::next(){
+    if(finished){
+      return false;
+    }
+    bool found = order == WordOrder::Shortlex ? nextShortlex() : nextLexicographic();
+    if(!found){
+      finished = true;
+      word.clear();
+    }
+    return found;
+  }
+
+  /**
+   * @brief go to the next word and iterate from it.
+   *
+   * @return Iterator the end if every word has been given
+   */
+  WordEnumerator::Iterator WordEnumerator::begin(){
+    return Iterator(next() ? this : nullptr);
+  }
+
+  /**
+   * @brief get the end of the iteration.
+   *
+   * @return Iterator
+   */
+  WordEnumerator::Iterator WordEnumerator::end(){
+    return Iterator(nullptr);
+  }
+
+  /**
+   * @brief compute the states accepting a word of every length up to a given one. A state
+   * accepts a word of a length if one of its targets accepts a word of the length below. If no
+   * state accepts a word of a length, none accepts a longer one.
+   *
+   * @param length the length
+   * @return true (a state accepts a word of the length)
+   * @return false (no word of the length or longer is accepted)
+   */
+  bool WordEnumerator::addLengths(std::size_t length){
+    if(lengths.empty()){
+      lengths = finals;
+    }
+    while(lengths.size() <= length * states){
+      std::size_t below = lengths.size() - states;
+      for(std::size_t i = 0; i < states; i++){
+        bool accepted = false;
+        for(std::size_t t = first[i]; t < first[i + 1] && !accepted; t++){
+          accepted = lengths[below + targets[t]];
+        }
+        lengths.push_back(accepted);
+      }
+    }
+    for(std::size_t i = 0; i < states; i++){
+      if(lengths[length * states + i]){
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief complete the word from a position, taking at every position the first transition
+   * whose target accepts a word of the remaining length.
+   *
+   * @param position the first position to complete, the state before it being known
+   */
+  void WordEnumerator::descend(std::size_t position){
+    for(std::size_t i = position; i < word.size(); i++){
+      std::size_t remaining = (word.size() - i - 1) * states;
+      std::size_t t = first[path[i]];
+      while(!lengths[remaining + targets[t]]){
+        t++;
+      }
+      links[i] = t;
+      word[i] = letters[t];
+      path[i + 1] = targets[t];
+    }
+  }
+
+  /**
+   * @brief go to the next word of the same length: the last position which can take a later
+   * transition leading to a word of the remaining length takes it, then the positions after it
+   * are completed with the first letters.
+   *
+   * @return true (success)
+   * @return false (the current word is the last of its length)
+   */
+  bool WordEnumerator::advance(){
+    for(std::size_t i = word.size(); i-- > 0;){
+      std::size_t remaining = (word.size() - i - 1) * states;
+      for(std::size_t t = links[i] + 1; t < first[path[i] + 1]; t++){
+        if(lengths[remaining + targets[t]]){
+          links[i] = t;
+          word[i] = letters[t];
+          path[i + 1] = targets[t];
+          descend(i + 1);
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief go to the next word in shortlex order: the next one of the current length, or else
+   * the first one of the next length having words.
+   *
+   * @return true (success)
+   * @return false (every word has been given)
+   */
+  bool WordEnumerator::nextShortlex(){
+    std::size_t length = 0;
+    if(started){
+      if(advance()){
+        return true;
+      }
+      length = word.size() + 1;
+    }
+    started = true;
+
+    /* the trimmed automate reaches every state, so a length without word ends the language */
+    while(addLengths(length)){
+      if(lengths[length * states + initial]){
+        word.assign(length, Epsilon);
+        path.assign(length + 1, initial);
+        links.assign(length, 0);
+        descend(0);
+        return true;
+      }
+      length++;
+    }
+    return false;
+  }
+
+  /**
+   * @brief go to the next word in lexicographic order, by a depth-first search taking the
+   * transitions by letter. Every state of the trimmed automate leads to a final state, and the
+   * language being finite the search ends.
+   *
+   * @return true (success)
+   * @return false (every word has been given)
+   */
+  bool WordEnumerator::nextLexicographic(){
+    if(!started){
+      started = true;
+      path.assign(1, initial);
+      links.assign(1, first[initial]);
+      if(finals[initial]){
+        return true;
+      }
+    }
+
+    while(!path.empty()){
+      int state = path.back();
+      std::size_t t = links.back();
+      if(t < first[state + 1]){
+        links.back() = t + 1;
+        path.push_back(targets[t]);
+        links.push_back(first[targets[t]]);
+        word.push_back(letters[t]);
+        if(finals[targets[t]]){
+          return true;
+        }
+      }else{
+        path.pop_back();
+        links.pop_back();
+        if(!word.empty()){
+          word.pop_back();
+        }
+      }
+    }
+    return false;
+  }
+}
@@ -0,0 +1,130 @@
+#ifndef ENUMERATOR_H
+#define ENUMERATOR_H
+
+#include <cstddef>
+#include <iterator>       // std::input_iterator_tag
+#include <string>
+#include <vector>         // needed for the good working of std::vector
+
+#include "Automaton.h"    // fa::Automaton
+
+namespace fa {
+  enum class WordOrder{
+    Shortlex,       // by length, then in lexicographic order among the words of a length
+    Lexicographic   // in lexicographic order, a prefix first, no word for an infinite language
+  };
+
+  /**
+   * Enumerates the words accepted by an automaton one at a time, in shortlex or lexicographic order
+   *
+   * The automaton is determinized if needed and trimmed, so every branch explored leads to a
+   * word. Only the current word and its path are kept, plus in shortlex order the states that
+   * accept a word of every length up to the current one.
+   */
+  class WordEnumerator {
+  public:
+    class Iterator {
+    public:
+      using iterator_category = std::input_iterator_tag;
+      using value_type = std::string;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const std::string*;
+      using reference = const std::string&;
+
+      const std::string& operator*() const;
+      const std::string* operator->() const;
+      Iterator& operator++();
+
+      bool operator==(const Iterator& other) const{
+        return enumerator == other.enumerator;
+      }
+
+      bool operator!=(const Iterator& other) const{
+        return enumerator != other.enumerator;
+      }
+
+    private:
+      friend class WordEnumerator;
+
+      explicit Iterator(WordEnumerator* enumerator)
+      : enumerator(enumerator){
+      }
+
+      WordEnumerator* enumerator;   // nullptr once the words are exhausted
+    };
+
+    using iterator = Iterator;
+
+    /**
+     * Prepare the enumeration
+     *
+     * An infinite language has no lexicographic enumeration, as in a*b ordered ... < aab < ab < b
+     * no word comes first: in lexicographic order, next() then returns false at once, which
+     * isFinite() tells beforehand.
+     */
+    WordEnumerator(const Automaton& automaton, WordOrder order = WordOrder::Shortlex);
+
+    /**
+     * Tell if the language is finite, so the enumeration ends
+     */
+    bool isFinite() const{
+      return finite;
+    }
+
+    /**
+     * Go to the next word, false once every word has been given or at once for an infinite
+     * language in lexicographic order
+     */
+    bool next();
+
+    /**
+     * Get the current word, valid until the next call to next()
+     */
+    const std::string& getWord() const{
+      return word;
+    }
+
+    /**
+     * Go to the next word and iterate from it, the iterators sharing the enumeration
+     */
+    Iterator begin();
+    Iterator end();
+
+  private:
+    WordOrder order;
+    std::size_t states;
+    int initial;                        // -1 if there is no initial state
+    bool finite;
+    bool started;
+    bool finished;
+    std::vector<std::size_t> first;     // state -> first transition, states + 1 entries
+    std::vector<char> letters;          // transition -> letter, sorted by letter for every state
+    std::vector<int> targets;           // transition -> target
+    std::vector<bool> finals;           // state -> final
+    std::vector<bool> lengths;          // length * states + state -> a word of the length is accepted from the state
+
+    std::string word;
+    std::vector<int> path;              // position -> state before the letter, then the state reached
+    std::vector<std::size_t> links;     // position -> link taken (shortlex) or next link to take (lexicographic)
+
+    /**
+     * Compute the lengths up to the given one, false if no state accepts a word of this length
+     */
+    bool addLengths(std::size_t length);
+
+    /**
+     * Complete the word from a position with the first letters leading to a word of its length
+     */
+    void descend(std::size_t position);
+
+    /**
+     * Go to the next word of the same length, false if the current one is the last
+     */
+    bool advance();
+
+    bool nextShortlex();
+    bool nextLexicographic();
+  };
+}
+
+#endif // ENUMERATOR_H
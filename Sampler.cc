@@ -0,0 +1,179 @@
+/**
+ * @file Sampler.cc
+ * @author Pierre Viprey
+ * @brief Uniform drawing of the words accepted by an automate
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ */
+#include "Sampler.h"
+
+#include <cassert>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace fa {
+  /**
+   * @brief give the value of a weight relative to an exponent at least as large as its own,
+   * 0 if it is under the normal range of the doubles. Built from the bits of the power of
+   * two, as std::ldexp is too slow to be called for every transition.
+   *
+   * @param mantissa the mantissa of the weight
+   * @param shift the exponent of the weight minus the exponent it is relative to, not positive
+   * @return double
+   */
+  static double scale(double mantissa, int shift){
+    if(shift < -1022){
+      return 0.0;
+    }
+    std::uint64_t bits = std::uint64_t(1023 + shift) << 52;
+    double power;
+    std::memcpy(&power, &bits, sizeof(power));
+    return mantissa * power;
+  }
+
+  /**
+   * @brief prepare the drawing of words of a given length. A state accepts a word of a
+   * remaining length if one of its targets accepts a word of the length below, and its weight
+   * is then the sum of the weights of these targets. The sum is taken relative to the largest
+   * exponent of the targets, so only the terms below 2^-1022 of the largest one are lost, and
+   * the mantissa of a weight is 0 exactly when no word is accepted.
+   *
+   * @param automaton the automate, determinized if it is not deterministic
+   * @param length the length of the words
+   */
+  WordSampler::WordSampler(const Automaton& automaton, std::size_t length)
+  : length(length), states(0), initial(-1){
+    assert(automaton.isValid());
+
+    const Automaton dfa = automaton.isDeterministic() ? automaton : Automaton::createDeterministic(automaton);
+
+    /* the transitions are copied once, as contiguous arrays */
+    Successors successors = dfa.getSuccessors();
+    states = successors.finals.size();
+    begin = std::move(successors.begin);
+    letters = std::move(successors.letters);
+    targets = std::move(successors.targets);
+    for(std::size_t i = 0; i < states; i++){
+      if(successors.initials[i]){
+        initial = i;
+      }
+    }
+
+    accepted.assign((length + 1) * states, false);
+    weights.assign((length + 1) * states, Weight{0.0, 0});
+    for(std::size_t i = 0; i < states; i++){
+      if(successors.finals[i]){
+        accepted[i] = true;
+        weights[i] = Weight{0.5, 1};
+      }
+    }
+    for(std::size_t remaining = 1; remaining <= length; remaining++){
+      const Weight* below = weights.data() + (remaining - 1) * states;
+      for(std::size_t i = 0; i < states; i++){
+        /* the sum is kept relative to the largest exponent met, rescaled when a larger one comes */
+        double sum = 0.0;
+        int largest = INT_MIN;
+        for(std::size_t t = begin[i]; t < begin[i + 1]; t++){
+          const Weight& weight = below[targets[t]];
+          if(weight.mantissa > 0.0){
+            if(weight.exponent > largest){
+              sum = largest == INT_MIN ? 0.0 : scale(sum, largest - weight.exponent);
+              largest = weight.exponent;
+            }
+            sum += scale(weight.mantissa, weight.exponent - largest);
+          }
+        }
+        if(largest != INT_MIN){
+          int exponent = 0;
+          double mantissa = std::frexp(sum, &exponent);
+          accepted[remaining * states + i] = true;
+          weights[remaining * states + i] = Weight{mantissa, largest + exponent};
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief tell if no word of the length is accepted.
+   *
+   * @return true (success)
+   * @return false (failure)
+   */
+  bool WordSampler::isEmpty() const{
+    return initial == -1 || !accepted[length * states + initial];
+  }
+
+  /**
+   * @brief draw a word uniformly among the accepted words of the length.
+   *
+   * @param random the generator
+   * @return std::optional<std::string> nothing if no word of the length is accepted
+   */
+  std::optional<std::string> WordSampler::sample(std::mt19937_64& random) const{
+    if(isEmpty()){
+      return std::nullopt;
+    }
+    std::string word(length, fa::Epsilon);
+    draw(random, word.data());
+    return word;
+  }
+
+  /**
+   * @brief draw words uniformly among the accepted words of the length, one after the other
+   * in a buffer.
+   *
+   * @param random the generator
+   * @param buffer the words, count * length characters without separator
+   * @param count the number of words
+   * @return true (success)
+   * @return false (failure)
+   */
+  bool WordSampler::sample(std::mt19937_64& random, char* buffer, std::size_t count) const{
+    if(isEmpty()){
+      return false;
+    }
+    for(std::size_t w = 0; w < count; w++){
+      draw(random, buffer + w * length);
+    }
+    return true;
+  }
+
+  /**
+   * @brief draw a word, every transition being taken with a probability proportional to the
+   * weight of its target for the remaining length. The weight of the state is the sum of these
+   * weights, so they are compared relative to its exponent, whatever the other states weigh.
+   * The weights over 2^53 being rounded, the draw is uniform up to a relative error of about
+   * 2^-52 for every letter.
+   *
+   * @param random the generator
+   * @param word the buffer of the word, length characters
+   */
+  void WordSampler::draw(std::mt19937_64& random, char* word) const{
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    int state = initial;
+    for(std::size_t position = 0; position < length; position++){
+      std::size_t below = (length - position - 1) * states;
+      const Weight& total = weights[below + states + state];
+
+      /* the rounding can leave the draw past the last transition, which then keeps the last accepting one,
+       * the mantissa being 0 exactly for the targets accepting no word of the remaining length */
+      double drawn = uniform(random) * total.mantissa;
+      std::size_t chosen = begin[state + 1];
+      for(std::size_t t = begin[state]; t < begin[state + 1]; t++){
+        const Weight& weight = weights[below + targets[t]];
+        if(weight.mantissa > 0.0){
+          chosen = t;
+          drawn -= scale(weight.mantissa, weight.exponent - total.exponent);
+          if(drawn < 0.0){
+            break;
+          }
+        }
+      }
+      word[position] = letters[chosen];
+      state = targets[chosen];
+    }
+  }
+}
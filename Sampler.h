@@ -0,0 +1,79 @@
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include <cstddef>
+#include <optional>       // std::optional
+#include <random>         // std::mt19937_64
+#include <string>
+#include <vector>         // needed for the good working of std::vector
+
+#include "Automaton.h"    // fa::Automaton
+
+namespace fa {
+  /**
+   * Draws words of a fixed length uniformly among the words of this length accepted by an automaton
+   *
+   * The words accepted from every state are counted once for every remaining length. Every count
+   * is kept as a mantissa and its own exponent, so neither a huge count nor a tiny one next to it
+   * is lost, and a word is then drawn in O(length * degree).
+   *
+   * The draws are only as uniform as the counts are exact. The counts below 2^53 are exact, the
+   * larger ones are rounded to 53 significant bits, and each letter is chosen with a double drawn
+   * from 53 random bits. The probability of a word may therefore differ from the uniform one by
+   * a relative error of about length * 2^-52, which no statistical test can see but which is not
+   * zero. Exact counts would need a big number for every state and remaining length.
+   */
+  class WordSampler {
+  public:
+    /**
+     * Prepare the drawing of words of the given length, the automaton being determinized if needed
+     */
+    WordSampler(const Automaton& automaton, std::size_t length);
+
+    std::size_t getLength() const{
+      return length;
+    }
+
+    /**
+     * Tell if no word of the length is accepted, in which case nothing can be drawn
+     */
+    bool isEmpty() const;
+
+    /**
+     * Draw a word, nothing if no word of the length is accepted
+     */
+    std::optional<std::string> sample(std::mt19937_64& random) const;
+
+    /**
+     * Draw count words one after the other in a buffer of count * length characters
+     *
+     * Returns false, leaving the buffer untouched, if no word of the length is accepted.
+     */
+    bool sample(std::mt19937_64& random, char* buffer, std::size_t count) const;
+
+  private:
+    /**
+     * A count of words, mantissa * 2^exponent with the mantissa in [0.5, 1) or 0
+     */
+    struct Weight{
+      double mantissa;
+      int exponent;
+    };
+
+    std::size_t length;
+    std::size_t states;
+    int initial;                        // -1 if there is no initial state
+    std::vector<std::size_t> begin;     // state -> first transition, states + 1 entries
+    std::vector<char> letters;          // transition -> letter
+    std::vector<int> targets;           // transition -> target
+    std::vector<bool> accepted;         // remaining * states + state -> a word of the length is accepted from the state
+    std::vector<Weight> weights;        // remaining * states + state -> count of the words accepted from the state
+
+    /**
+     * Draw a word of the length in the buffer
+     */
+    void draw(std::mt19937_64& random, char* word) const;
+  };
+}
+
+#endif // SAMPLER_H
@@ -0,0 +1,60 @@
+#ifndef SHARED_H
+#define SHARED_H
+
+#include <memory>    // std::shared_ptr
+#include <utility>   // std::move
+
+namespace fa {
+  /**
+   * A value shared by the copies of its owner until one of them changes it
+   *
+   * Copying is a reference count increment. Reading is free, and writing first
+   * makes a private copy of the value if it is still shared (copy-on-write).
+   */
+  template<typename T>
+  class Shared {
+  public:
+    Shared() = default;
+
+    explicit Shared(T other)
+    : value(std::make_shared<T>(std::move(other))){
+    }
+
+    const T& operator*() const{
+      return value ? *value : empty();
+    }
+
+    const T* operator->() const{
+      return &**this;
+    }
+
+    /**
+     * Give the value for a change, after copying it if it is shared
+     */
+    T& write(){
+      if(!value){
+        value = std::make_shared<T>();
+      }else if(value.use_count() > 1){
+        value = std::make_shared<T>(*value);
+      }
+      return *value;
+    }
+
+    /**
+     * Tell if the two values are the same object
+     */
+    bool isSharedWith(const Shared& other) const{
+      return value == other.value;
+    }
+
+  private:
+    std::shared_ptr<T> value;   // null until written or once moved from, read as empty
+
+    static const T& empty(){
+      static const T value;
+      return value;
+    }
+  };
+}
+
+#endif // SHARED_H
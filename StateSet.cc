@@ -0,0 +1,605 @@
+/**
+ * @file StateSet.cc
+ * @author Pierre Viprey
+ * @brief Management of sets of states
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ */
+#include "StateSet.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace fa {
+  /**
+   * @brief count the zeros below the lowest bit set of a non-zero word.
+   *
+   * @param word the word
+   * @return int
+   */
+  static int countTrailingZeros(std::uint64_t word){
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int zeros = 0;
+    while((word & 1) == 0){
+      word >>= 1;
+      zeros++;
+    }
+    return zeros;
+#endif
+  }
+
+  /**
+   * @brief count the bits set in a word.
+   *
+   * @param word the word
+   * @return int
+   */
+  static int countBits(std::uint64_t word){
+#if defined(__GNUC__)
+    return __builtin_popcountll(word);
+#else
+    int bits = 0;
+    for(; word != 0; word &= word - 1){
+      bits++;
+    }
+    return bits;
+#endif
+  }
+
+  /**
+   * @brief the state at the current position.
+   *
+   * @return int
+   */
+  int StateSet::Iterator::operator*() const{
+    if(set->mode == Mode::Sorted){
+      return set->data()[position];
+    }
+    return static_cast<int>(position);
+  }
+
+  /**
+   * @brief go to the next state, in increasing order.
+   *
+   * @return Iterator&
+   */
+  StateSet::Iterator& StateSet::Iterator::operator++(){
+    if(set->mode == Mode::Sorted){
+      position++;
+    }else{
+      position = set->nextBit(position + 1);
+    }
+    return *this;
+  }
+
+  StateSet::Iterator StateSet::Iterator::operator++(int){
+    Iterator previous = *this;
+    ++(*this);
+    return previous;
+  }
+
+  /**
+   * @brief Construct an empty StateSet
+   *
+   * @param resource the memory of the storage when it is not inline
+   */
+  StateSet::StateSet(std::pmr::memory_resource* resource)
+  : resource(resource), hashValue(0), count(0), capacity(InlineCapacity), mode(Mode::Sorted){
+  }
+
+  /**
+   * @brief Construct a StateSet from a list of states
+   *
+   * @param states the states, in any order
+   */
+  StateSet::StateSet(std::initializer_list<int> states)
+  : StateSet(states.begin(), states.end()){
+  }
+
+  StateSet::StateSet(const StateSet& other)
+  : StateSet(other, other.resource){
+  }
+
+  /**
+   * @brief Construct a copy of a StateSet drawing from another resource
+   *
+   * @param other the set to copy
+   * @param resource the memory of the copy
+   */
+  StateSet::StateSet(const StateSet& other, std::pmr::memory_resource* resource)
+  : StateSet(resource){
+    if(other.mode == Mode::Bits){
+      words = static_cast<std::uint64_t*>(resource->allocate(other.capacity * sizeof(std::uint64_t), alignof(std::uint64_t)));
+      std::memcpy(words, other.words, other.capacity * sizeof(std::uint64_t));
+      capacity = other.capacity;
+      mode = Mode::Bits;
+    }else{
+      std::copy(other.data(), other.data() + other.count, prepareSorted(other.count));
+    }
+    count = other.count;
+    hashValue = other.hashValue;
+  }
+
+  StateSet::StateSet(StateSet&& other) noexcept
+  : resource(other.resource), hashValue(other.hashValue), count(other.count), capacity(other.capacity), mode(other.mode){
+    std::memcpy(small, other.small, sizeof(small));
+    other.hashValue = 0;
+    other.count = 0;
+    other.capacity = InlineCapacity;
+    other.mode = Mode::Sorted;
+  }
+
+  StateSet& StateSet::operator=(const StateSet& other){
+    if(this != &other){
+      *this = StateSet(other, resource);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief move a set, its storage is taken if it comes from the same resource
+   *
+   * @param other the set to move
+   * @return StateSet&
+   */
+  StateSet& StateSet::operator=(StateSet&& other) noexcept{
+    if(this == &other){
+      return *this;
+    }
+    if(!(*resource == *other.resource)){
+      StateSet copy(other, resource);
+      return *this = std::move(copy);
+    }
+    release();
+    hashValue = other.hashValue;
+    count = other.count;
+    capacity = other.capacity;
+    mode = other.mode;
+    std::memcpy(small, other.small, sizeof(small));
+    other.hashValue = 0;
+    other.count = 0;
+    other.capacity = InlineCapacity;
+    other.mode = Mode::Sorted;
+    return *this;
+  }
+
+  StateSet::~StateSet(){
+    release();
+  }
+
+  /**
+   * @brief give the storage back and become an empty inline set.
+   *
+   */
+  void StateSet::release(){
+    if(mode == Mode::Bits){
+      resource->deallocate(words, capacity * sizeof(std::uint64_t), alignof(std::uint64_t));
+    }else if(!isInline()){
+      resource->deallocate(sorted, capacity * sizeof(int), alignof(int));
+    }
+    hashValue = 0;
+    count = 0;
+    capacity = InlineCapacity;
+    mode = Mode::Sorted;
+  }
+
+  /**
+   * @brief make room for a sorted array, the sorted storage is kept if large enough.
+   *
+   * @param size the number of states
+   * @return int* the array to fill
+   */
+  int* StateSet::prepareSorted(std::size_t size){
+    if(mode != Mode::Sorted || size > capacity){
+      release();
+      if(size > InlineCapacity){
+        sorted = static_cast<int*>(resource->allocate(size * sizeof(int), alignof(int)));
+        capacity = size;
+      }
+    }
+    hashValue = 0;
+    count = 0;
+    return data();
+  }
+
+  /**
+   * @brief replace the content by a sorted range without duplicates.
+   *
+   * @param first the first state
+   * @param last the end of the range
+   */
+  void StateSet::assign(const int* first, const int* last){
+    assert(std::is_sorted(first, last));
+    std::size_t size = last - first;
+    if(size > 0 && *first >= 0 && shouldBeDense(size, last[-1])){
+      std::size_t needed = static_cast<std::size_t>(last[-1]) / 64 + 1;
+      if(mode != Mode::Bits || capacity < needed){
+        release();
+        words = static_cast<std::uint64_t*>(resource->allocate(needed * sizeof(std::uint64_t), alignof(std::uint64_t)));
+        capacity = needed;
+        mode = Mode::Bits;
+      }
+      std::fill(words, words + capacity, 0);
+      for(const int* it = first; it != last; ++it){
+        words[*it / 64] |= std::uint64_t(1) << (*it % 64);
+      }
+    }else{
+      std::copy(first, last, prepareSorted(size));
+    }
+    count = size;
+    hashValue = 0;
+    for(const int* it = first; it != last; ++it){
+      hashValue += mix(*it);
+    }
+  }
+
+  /**
+   * @brief tell if a bitset would be smaller than the sorted array.
+   *
+   * @param count the number of states
+   * @param maximum the greatest state, not negative
+   * @return true if the set should be a bitset
+   */
+  bool StateSet::shouldBeDense(std::size_t count, int maximum){
+    return count > InlineCapacity && (static_cast<std::size_t>(maximum) / 64 + 1) * 2 < count;
+  }
+
+  /**
+   * @brief store the set, sorted and without negative state, as a bitset.
+   *
+   * @param maximum the greatest state
+   */
+  void StateSet::convertToBits(int maximum){
+    assert(mode == Mode::Sorted);
+    std::size_t size = static_cast<std::size_t>(maximum) / 64 + 1;
+    std::uint64_t* bits = static_cast<std::uint64_t*>(resource->allocate(size * sizeof(std::uint64_t), alignof(std::uint64_t)));
+    std::fill(bits, bits + size, 0);
+    for(const int* it = data(); it != data() + count; ++it){
+      bits[*it / 64] |= std::uint64_t(1) << (*it % 64);
+    }
+    if(!isInline()){
+      resource->deallocate(sorted, capacity * sizeof(int), alignof(int));
+    }
+    words = bits;
+    capacity = size;
+    mode = Mode::Bits;
+  }
+
+  /**
+   * @brief store the bitset as a sorted array.
+   *
+   */
+  void StateSet::convertToSorted(){
+    assert(mode == Mode::Bits);
+    std::uint64_t* bits = words;
+    std::uint32_t size = capacity;
+    std::uint32_t states = count;
+    std::size_t hash = hashValue;
+
+    mode = Mode::Sorted;
+    capacity = InlineCapacity;
+    int* it = prepareSorted(states);
+    for(std::uint32_t w = 0; w < size; w++){
+      for(std::uint64_t word = bits[w]; word != 0; word &= word - 1){
+        *it++ = w * 64 + countTrailingZeros(word);
+      }
+    }
+    resource->deallocate(bits, size * sizeof(std::uint64_t), alignof(std::uint64_t));
+    count = states;
+    hashValue = hash;
+  }
+
+  /**
+   * @brief find the first state of the bitset from the given bit.
+   *
+   * @param bit the first bit to look at
+   * @return std::size_t the state, or the end of the bitset if none
+   */
+  std::size_t StateSet::nextBit(std::size_t bit) const{
+    std::size_t w = bit / 64;
+    if(w >= capacity){
+      return capacity * 64;
+    }
+    std::uint64_t word = words[w] & (~std::uint64_t(0) << (bit % 64));
+    while(word == 0){
+      if(++w == capacity){
+        return capacity * 64;
+      }
+      word = words[w];
+    }
+    return w * 64 + countTrailingZeros(word);
+  }
+
+  /**
+   * @brief compute the hash of a set built in place, then choose its storage.
+   *
+   */
+  void StateSet::finish(){
+    hashValue = 0;
+    int first = count > 0 ? *begin() : 0;
+    int last = 0;
+    for(int state : *this){
+      hashValue += mix(state);
+      last = state;
+    }
+    if(mode == Mode::Sorted){
+      if(count > 0 && first >= 0 && shouldBeDense(count, last)){
+        convertToBits(last);
+      }
+    }else if(count == 0 || !shouldBeDense(count, last)){
+      convertToSorted();
+    }
+  }
+
+  /**
+   * @brief the part of a state in the hash, the hash of a set being their sum.
+   *
+   * @param state the state
+   * @return std::size_t
+   */
+  std::size_t StateSet::mix(int state){
+    std::uint64_t x = static_cast<std::uint32_t>(state) + 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return static_cast<std::size_t>(x ^ (x >> 31));
+  }
+
+  /**
+   * @brief add a state to the set.
+   *
+   * @param state the state
+   * @return true (success)
+   * @return false (already there)
+   */
+  bool StateSet::insert(int state){
+    if(mode == Mode::Bits){
+      if(state >= 0 && static_cast<std::size_t>(state) < capacity * std::size_t(64)){
+        std::uint64_t bit = std::uint64_t(1) << (state % 64);
+        if(words[state / 64] & bit){
+          return false;
+        }
+        words[state / 64] |= bit;
+        count++;
+        hashValue += mix(state);
+        return true;
+      }
+      if(state >= 0 && shouldBeDense(count + 1, state)){
+        std::size_t size = std::max<std::size_t>(2 * capacity, state / 64 + 1);
+        std::uint64_t* bits = static_cast<std::uint64_t*>(resource->allocate(size * sizeof(std::uint64_t), alignof(std::uint64_t)));
+        std::copy(words, words + capacity, bits);
+        std::fill(bits + capacity, bits + size, 0);
+        resource->deallocate(words, capacity * sizeof(std::uint64_t), alignof(std::uint64_t));
+        words = bits;
+        capacity = size;
+        return insert(state);
+      }
+      convertToSorted();
+    }
+
+    int* first = data();
+    int* position = std::lower_bound(first, first + count, state);
+    if(position != first + count && *position == state){
+      return false;
+    }
+    std::size_t offset = position - first;
+    if(count == capacity){
+      std::size_t size = 2 * capacity;
+      int* array = static_cast<int*>(resource->allocate(size * sizeof(int), alignof(int)));
+      std::copy(first, position, array);
+      std::copy(position, first + count, array + offset + 1);
+      if(!isInline()){
+        resource->deallocate(sorted, capacity * sizeof(int), alignof(int));
+      }
+      sorted = array;
+      capacity = size;
+    }else{
+      std::copy_backward(position, first + count, first + count + 1);
+    }
+    first = data();
+    first[offset] = state;
+    count++;
+    hashValue += mix(state);
+
+    if(first[0] >= 0 && shouldBeDense(count, first[count - 1])){
+      convertToBits(first[count - 1]);
+    }
+    return true;
+  }
+
+  /**
+   * @brief remove a state from the set, the storage is kept.
+   *
+   * @param state the state
+   * @return true (success)
+   * @return false (not there)
+   */
+  bool StateSet::erase(int state){
+    if(!contains(state)){
+      return false;
+    }
+    if(mode == Mode::Bits){
+      words[state / 64] &= ~(std::uint64_t(1) << (state % 64));
+    }else{
+      int* first = data();
+      int* position = std::lower_bound(first, first + count, state);
+      std::copy(position + 1, first + count, position);
+    }
+    count--;
+    hashValue -= mix(state);
+    return true;
+  }
+
+  /**
+   * @brief remove every state, the storage is kept.
+   *
+   */
+  void StateSet::clear(){
+    if(mode == Mode::Bits){
+      std::fill(words, words + capacity, 0);
+    }
+    count = 0;
+    hashValue = 0;
+  }
+
+  /**
+   * @brief tell if the state is in the set.
+   *
+   * @param state the state
+   * @return true (success)
+   * @return false (failure)
+   */
+  bool StateSet::contains(int state) const{
+    if(mode == Mode::Bits){
+      return state >= 0 && static_cast<std::size_t>(state) < capacity * std::size_t(64)
+        && (words[state / 64] >> (state % 64) & 1);
+    }
+    return std::binary_search(data(), data() + count, state);
+  }
+
+  /**
+   * @brief find a state in the set.
+   *
+   * @param state the state
+   * @return Iterator the position of the state, end() if it is not in the set
+   */
+  StateSet::Iterator StateSet::find(int state) const{
+    if(mode == Mode::Bits){
+      return contains(state) ? Iterator(this, state) : end();
+    }
+    const int* position = std::lower_bound(data(), data() + count, state);
+    if(position != data() + count && *position == state){
+      return Iterator(this, position - data());
+    }
+    return end();
+  }
+
+  /**
+   * @brief tell if every state of the set is in the other one.
+   *
+   * @param other the other set
+   * @return true (success)
+   * @return false (failure)
+   */
+  bool StateSet::isIncludedIn(const StateSet& other) const{
+    if(count > other.count){
+      return false;
+    }
+    if(mode == Mode::Bits && other.mode == Mode::Bits){
+      for(std::uint32_t w = 0; w < capacity; w++){
+        if(words[w] & ~(w < other.capacity ? other.words[w] : 0)){
+          return false;
+        }
+      }
+      return true;
+    }
+    if(mode == Mode::Sorted && other.mode == Mode::Sorted){
+      return std::includes(other.data(), other.data() + other.count, data(), data() + count);
+    }
+    for(int state : *this){
+      if(!other.contains(state)){
+        return false;
+      }
+    }
+    return true;
+  }
+
+  StateSet::Iterator StateSet::begin() const{
+    return Iterator(this, mode == Mode::Sorted ? 0 : nextBit(0));
+  }
+
+  StateSet::Iterator StateSet::end() const{
+    return Iterator(this, mode == Mode::Sorted ? count : capacity * std::size_t(64));
+  }
+
+  /**
+   * @brief create the union of two sets, drawing from the resource of the first one.
+   *
+   * @param lhs the first set
+   * @param rhs the second set
+   * @return StateSet
+   */
+  StateSet StateSet::createUnion(const StateSet& lhs, const StateSet& rhs){
+    StateSet result(lhs.resource);
+    if(lhs.mode == Mode::Bits && rhs.mode == Mode::Bits){
+      const StateSet& large = lhs.capacity >= rhs.capacity ? lhs : rhs;
+      const StateSet& small = lhs.capacity >= rhs.capacity ? rhs : lhs;
+      result = StateSet(large, lhs.resource);
+      for(std::uint32_t w = 0; w < small.capacity; w++){
+        result.words[w] |= small.words[w];
+      }
+      result.count = 0;
+      for(std::uint32_t w = 0; w < result.capacity; w++){
+        result.count += countBits(result.words[w]);
+      }
+    }else{
+      int* first = result.prepareSorted(lhs.count + rhs.count);
+      result.count = std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), first) - first;
+    }
+    result.finish();
+    return result;
+  }
+
+  /**
+   * @brief create the intersection of two sets, drawing from the resource of the first one.
+   *
+   * @param lhs the first set
+   * @param rhs the second set
+   * @return StateSet
+   */
+  StateSet StateSet::createIntersection(const StateSet& lhs, const StateSet& rhs){
+    StateSet result(lhs.resource);
+    if(lhs.mode == Mode::Bits && rhs.mode == Mode::Bits){
+      result = StateSet(lhs.capacity <= rhs.capacity ? lhs : rhs, lhs.resource);
+      const StateSet& other = lhs.capacity <= rhs.capacity ? rhs : lhs;
+      result.count = 0;
+      for(std::uint32_t w = 0; w < result.capacity; w++){
+        result.words[w] &= other.words[w];
+        result.count += countBits(result.words[w]);
+      }
+    }else if(lhs.mode == Mode::Bits || rhs.mode == Mode::Bits){
+      const StateSet& bits = lhs.mode == Mode::Bits ? lhs : rhs;
+      const StateSet& array = lhs.mode == Mode::Bits ? rhs : lhs;
+      int* first = result.prepareSorted(array.count);
+      for(const int* it = array.data(); it != array.data() + array.count; ++it){
+        if(bits.contains(*it)){
+          first[result.count++] = *it;
+        }
+      }
+    }else{
+      int* first = result.prepareSorted(std::min(lhs.count, rhs.count));
+      result.count = std::set_intersection(lhs.data(), lhs.data() + lhs.count, rhs.data(), rhs.data() + rhs.count, first) - first;
+    }
+    result.finish();
+    return result;
+  }
+
+  /**
+   * @brief compare two sets, whatever their storage.
+   *
+   * @param lhs the first set
+   * @param rhs the second set
+   * @return true if they have the same states
+   */
+  bool operator==(const StateSet& lhs, const StateSet& rhs){
+    if(lhs.count != rhs.count || lhs.hashValue != rhs.hashValue){
+      return false;
+    }
+    if(lhs.mode == StateSet::Mode::Sorted && rhs.mode == StateSet::Mode::Sorted){
+      return std::equal(lhs.data(), lhs.data() + lhs.count, rhs.data());
+    }
+    if(lhs.mode == StateSet::Mode::Bits && rhs.mode == StateSet::Mode::Bits){
+      /* the same states, so the words past the shortest bitset are zero */
+      std::uint32_t size = std::min(lhs.capacity, rhs.capacity);
+      return std::equal(lhs.words, lhs.words + size, rhs.words);
+    }
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+  bool operator!=(const StateSet& lhs, const StateSet& rhs){
+    return !(lhs == rhs);
+  }
+}
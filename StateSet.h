@@ -0,0 +1,235 @@
+#ifndef STATE_SET_H
+#define STATE_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>        // std::hash
+#include <initializer_list>
+#include <iterator>          // std::forward_iterator_tag
+#include <memory_resource>   // std::pmr::memory_resource
+
+namespace fa {
+  /**
+   * A set of states (numbers or indexes), iterated in increasing order
+   *
+   * A small set is stored inline, a larger one in a sorted array, and a dense one
+   * of non-negative states as a bitset. The hash does not depend on the storage
+   * and is kept up to date, so comparing two sets is cheap when they differ.
+   */
+  class StateSet {
+  public:
+    class Iterator {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = int;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const int*;
+      using reference = int;
+
+      int operator*() const;
+      Iterator& operator++();
+      Iterator operator++(int);
+
+      bool operator==(const Iterator& other) const{
+        return position == other.position;
+      }
+
+      bool operator!=(const Iterator& other) const{
+        return position != other.position;
+      }
+
+    private:
+      friend class StateSet;
+
+      Iterator(const StateSet* set, std::size_t position)
+      : set(set), position(position){
+      }
+
+      const StateSet* set;
+      std::size_t position;   // index in the sorted array, or bit of the bitset
+    };
+
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+    /**
+     * Build an empty set, its storage drawn from the resource when not inline
+     */
+    explicit StateSet(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    /**
+     * Build the set of the given states
+     */
+    StateSet(std::initializer_list<int> states);
+
+    /**
+     * Build the set of the states of a range, in any order and with duplicates
+     */
+    template<typename InputIterator>
+    StateSet(InputIterator first, InputIterator last, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+    : StateSet(resource){
+      for(; first != last; ++first){
+        insert(*first);
+      }
+    }
+
+    /**
+     * Copy a set, the copy drawing from the resource of the original or from the given one
+     */
+    StateSet(const StateSet& other);
+    StateSet(const StateSet& other, std::pmr::memory_resource* resource);
+
+    StateSet(StateSet&& other) noexcept;
+    StateSet& operator=(const StateSet& other);
+    StateSet& operator=(StateSet&& other) noexcept;
+    ~StateSet();
+
+    /**
+     * Replace the content by a sorted range without duplicates, keeping the storage if possible
+     */
+    void assign(const int* first, const int* last);
+
+    /**
+     * Add a state, returns true if the state was effectively added
+     */
+    bool insert(int state);
+
+    /**
+     * Remove a state, returns true if the state was effectively removed
+     */
+    bool erase(int state);
+
+    /**
+     * Remove every state, the storage is kept
+     */
+    void clear();
+
+    /**
+     * Tell if the state is in the set
+     */
+    bool contains(int state) const;
+
+    /**
+     * Find a state, end() if it is not in the set
+     */
+    Iterator find(int state) const;
+
+    /**
+     * Tell if every state of the set is in the other one
+     */
+    bool isIncludedIn(const StateSet& other) const;
+
+    std::size_t size() const{
+      return count;
+    }
+
+    bool empty() const{
+      return count == 0;
+    }
+
+    Iterator begin() const;
+    Iterator end() const;
+
+    /**
+     * The hash of the states, computed when they are added
+     */
+    std::size_t hash() const{
+      return hashValue;
+    }
+
+    /**
+     * Tell if the set is stored as a bitset
+     */
+    bool isDense() const{
+      return mode == Mode::Bits;
+    }
+
+    std::pmr::memory_resource* getResource() const{
+      return resource;
+    }
+
+    /**
+     * Create the union and the intersection of two sets
+     */
+    static StateSet createUnion(const StateSet& lhs, const StateSet& rhs);
+    static StateSet createIntersection(const StateSet& lhs, const StateSet& rhs);
+
+    friend bool operator==(const StateSet& lhs, const StateSet& rhs);
+    friend bool operator!=(const StateSet& lhs, const StateSet& rhs);
+
+  private:
+    static constexpr std::uint32_t InlineCapacity = 4;
+
+    enum class Mode : std::uint8_t{
+      Sorted,   // small[] if the capacity is InlineCapacity, sorted[] otherwise
+      Bits      // words[], the state s is the bit s % 64 of the word s / 64
+    };
+
+    std::pmr::memory_resource* resource;
+    std::size_t hashValue;
+    std::uint32_t count;
+    std::uint32_t capacity;   // ints of the sorted array or words of the bitset
+    Mode mode;
+    union{
+      int small[InlineCapacity];
+      int* sorted;
+      std::uint64_t* words;
+    };
+
+    bool isInline() const{
+      return mode == Mode::Sorted && capacity == InlineCapacity;
+    }
+
+    const int* data() const{
+      return isInline() ? small : sorted;
+    }
+
+    int* data(){
+      return isInline() ? small : sorted;
+    }
+
+    /**
+     * Give the storage back and become an empty inline set
+     */
+    void release();
+
+    /**
+     * Make room for a sorted array of the given size, the content is lost
+     */
+    int* prepareSorted(std::size_t size);
+
+    /**
+     * Store the set as a bitset or as a sorted array
+     */
+    void convertToBits(int maximum);
+    void convertToSorted();
+
+    /**
+     * Tell if a bitset would be smaller than the sorted array
+     */
+    static bool shouldBeDense(std::size_t count, int maximum);
+
+    /**
+     * Find the first state of the bitset from the given bit, the end of the bitset if none
+     */
+    std::size_t nextBit(std::size_t bit) const;
+
+    /**
+     * Finish a set built in place: compute the hash, then choose the storage
+     */
+    void finish();
+
+    static std::size_t mix(int state);
+  };
+}
+
+namespace std {
+  template<>
+  struct hash<fa::StateSet>{
+    std::size_t operator()(const fa::StateSet& set) const{
+      return set.hash();
+    }
+  };
+}
+
+#endif // STATE_SET_H
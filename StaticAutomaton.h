@@ -0,0 +1,547 @@
+#ifndef STATIC_AUTOMATON_H
+#define STATIC_AUTOMATON_H
+
+#include <cstddef>
+#include <cstdint>
+#include <array>          // std::array
+#include <stdexcept>      // std::logic_error
+#include <string_view>    // std::string_view
+#include <type_traits>    // std::conditional_t
+
+namespace fa {
+  /**
+   * A transition of a deterministic automaton described at compile time
+   */
+  struct StaticTransition{
+    int from;
+    char letter;
+    int to;
+  };
+
+  /**
+   * A deterministic automaton described at compile time, the states being 0..States-1
+   */
+  template<std::size_t States, std::size_t Transitions>
+  struct StaticDescription{
+    int initial;
+    std::array<bool, States> finals;
+    std::array<StaticTransition, Transitions> transitions;
+  };
+
+  /**
+   * A deterministic automaton built at compile time
+   *
+   * The letters having the same transitions share a class, and the table gives the
+   * target of every state for every class. The missing transitions go to a sink,
+   * numbered States. Everything is constexpr: there is no allocation, no startup
+   * cost, and a word known at compile time can be matched in a static_assert.
+   */
+  template<std::size_t States, std::size_t Classes>
+  class StaticAutomaton{
+  public:
+    static_assert(States > 0 && States < 0xFFFF, "a static automaton has between 1 and 65534 states");
+
+    using Index = std::conditional_t<(States < 0xFF), std::uint8_t, std::uint16_t>;
+    static constexpr Index Sink = States;
+
+    /**
+     * Build an automaton with only the initial state 0, rejecting every word
+     */
+    constexpr StaticAutomaton()
+    : letterClass{}, table{}, finals{}, initial(0){
+      for(auto &row : table){
+        for(auto &target : row){
+          target = Sink;
+        }
+      }
+    }
+
+    /**
+     * Tell if the word is in the language accepted by the automaton
+     */
+    constexpr bool match(std::string_view word) const{
+      std::size_t state = initial;
+      for(char letter : word){
+        state = table[state][letterClass[static_cast<unsigned char>(letter)]];
+        if(state == Sink){
+          return false;
+        }
+      }
+      return finals[state];
+    }
+
+    static constexpr std::size_t countStates(){
+      return States;
+    }
+
+    static constexpr std::size_t countClasses(){
+      return Classes;
+    }
+
+    constexpr int getInitialState() const{
+      return initial;
+    }
+
+    constexpr bool isStateFinal(int state) const{
+      return finals[state];
+    }
+
+    /**
+     * The target of the transition, -1 if there is none
+     */
+    constexpr int getTarget(int state, char letter) const{
+      Index target = table[state][letterClass[static_cast<unsigned char>(letter)]];
+      return target == Sink ? -1 : target;
+    }
+
+    std::array<std::uint8_t, 256> letterClass;
+    std::array<std::array<Index, Classes>, States + 1> table;
+    std::array<bool, States + 1> finals;
+    Index initial;
+  };
+
+  namespace detail {
+    /**
+     * Make the constant evaluation fail with a message
+     */
+    constexpr void require(bool condition, const char* message){
+      if(!condition){
+        throw std::logic_error(message);
+      }
+    }
+
+    /**
+     * A deterministic automaton during its construction, with room for the largest one
+     */
+    struct StaticTable{
+      static constexpr std::size_t MaxStates = 256;
+      static constexpr std::size_t MaxClasses = 128;
+
+      std::size_t states = 0;
+      std::size_t classes = 0;
+      int initial = 0;
+      std::array<std::uint8_t, 256> letterClass{};
+      std::array<std::array<int, MaxClasses>, MaxStates> table{};   // -1 for the sink
+      std::array<bool, MaxStates> finals{};
+    };
+
+    /**
+     * Group the letters having the same target in every state of a description
+     */
+    template<std::size_t States, std::size_t Transitions>
+    constexpr StaticTable compileDescription(const StaticDescription<States, Transitions>& description){
+      require(States <= StaticTable::MaxStates, "too many states for a static automaton");
+      require(description.initial >= 0 && static_cast<std::size_t>(description.initial) < States, "the initial state does not exist");
+
+      /* the target of every state for every letter */
+      std::array<std::array<int, 256>, States> targets{};
+      for(auto &row : targets){
+        for(auto &target : row){
+          target = -1;
+        }
+      }
+      for(auto const &transition : description.transitions){
+        require(transition.from >= 0 && static_cast<std::size_t>(transition.from) < States, "a transition leaves a state that does not exist");
+        require(transition.to >= 0 && static_cast<std::size_t>(transition.to) < States, "a transition goes to a state that does not exist");
+        int& target = targets[transition.from][static_cast<unsigned char>(transition.letter)];
+        require(target == -1 || target == transition.to, "the description is not deterministic");
+        target = transition.to;
+      }
+
+      StaticTable result;
+      result.states = States;
+      result.initial = description.initial;
+      std::array<int, StaticTable::MaxClasses> representative{};
+      for(std::size_t letter = 0; letter < 256; letter++){
+        std::size_t c = 0;
+        for(; c < result.classes; c++){
+          bool same = true;
+          for(std::size_t state = 0; state < States && same; state++){
+            same = targets[state][letter] == targets[state][representative[c]];
+          }
+          if(same){
+            break;
+          }
+        }
+        if(c == result.classes){
+          require(result.classes < StaticTable::MaxClasses, "too many classes of letters for a static automaton");
+          representative[result.classes++] = letter;
+        }
+        result.letterClass[letter] = c;
+      }
+      for(std::size_t state = 0; state < States; state++){
+        result.finals[state] = description.finals[state];
+        for(std::size_t c = 0; c < result.classes; c++){
+          result.table[state][c] = targets[state][representative[c]];
+        }
+      }
+      return result;
+    }
+
+    /**
+     * The Glushkov automaton of a regular expression: a state per letter of the
+     * expression, and the letters that can follow each one.
+     *
+     * The expression may use literal letters, '.', classes such as [a-z] or [^,],
+     * the escapes \d \w \s (and \ before any other letter to take it literally),
+     * groups, '|', '*', '+' and '?'.
+     */
+    class Glushkov{
+    public:
+      static constexpr std::size_t MaxPositions = 63;
+      static constexpr std::uint64_t Start = std::uint64_t(1) << MaxPositions;
+
+      constexpr explicit Glushkov(std::string_view pattern)
+      : pattern(pattern), index(0), positions(0), letterMask{}, follow{}, nullable(false), last(0){
+        Fragment root = parseAlternation();
+        require(index == pattern.size(), "unbalanced ')' in the regular expression");
+        follow[MaxPositions] = root.first;
+        nullable = root.nullable;
+        last = root.last;
+      }
+
+      /**
+       * Determinize the automaton over the classes of letters reaching the same positions
+       */
+      constexpr StaticTable createTable() const{
+        StaticTable result;
+
+        std::array<std::uint64_t, StaticTable::MaxClasses> classMask{};
+        for(std::size_t letter = 0; letter < 256; letter++){
+          std::size_t c = 0;
+          while(c < result.classes && classMask[c] != letterMask[letter]){
+            c++;
+          }
+          if(c == result.classes){
+            require(result.classes < StaticTable::MaxClasses, "too many classes of letters for a static automaton");
+            classMask[result.classes++] = letterMask[letter];
+          }
+          result.letterClass[letter] = c;
+        }
+
+        std::array<std::uint64_t, StaticTable::MaxStates> subsets{};
+        subsets[0] = Start;
+        result.states = 1;
+        for(std::size_t state = 0; state < result.states; state++){
+          std::uint64_t next = 0;
+          for(std::size_t p = 0; p <= MaxPositions; p++){
+            if(subsets[state] >> p & 1){
+              next |= follow[p];
+            }
+          }
+          result.finals[state] = (subsets[state] & last) != 0 || (subsets[state] == Start && nullable);
+          for(std::size_t c = 0; c < result.classes; c++){
+            std::uint64_t target = next & classMask[c];
+            if(target == 0){
+              result.table[state][c] = -1;
+              continue;
+            }
+            std::size_t found = 0;
+            while(found < result.states && subsets[found] != target){
+              found++;
+            }
+            if(found == result.states){
+              require(result.states < StaticTable::MaxStates, "too many states for a static automaton");
+              subsets[result.states++] = target;
+            }
+            result.table[state][c] = found;
+          }
+        }
+        return result;
+      }
+
+    private:
+      struct Fragment{
+        bool nullable;
+        std::uint64_t first, last;
+      };
+
+      std::string_view pattern;
+      std::size_t index;
+      std::size_t positions;
+      std::array<std::uint64_t, 256> letterMask;            // letter -> positions accepting it
+      std::array<std::uint64_t, MaxPositions + 1> follow;   // position -> positions after it, Start last
+      bool nullable;
+      std::uint64_t last;
+
+      constexpr bool isAtEnd() const{
+        return index == pattern.size();
+      }
+
+      constexpr Fragment parseAlternation(){
+        Fragment result = parseConcatenation();
+        while(!isAtEnd() && pattern[index] == '|'){
+          index++;
+          Fragment other = parseConcatenation();
+          result = {result.nullable || other.nullable, result.first | other.first, result.last | other.last};
+        }
+        return result;
+      }
+
+      constexpr Fragment parseConcatenation(){
+        Fragment result = {true, 0, 0};
+        while(!isAtEnd() && pattern[index] != '|' && pattern[index] != ')'){
+          Fragment other = parseRepetition();
+          addFollow(result.last, other.first);
+          result = {
+            result.nullable && other.nullable,
+            result.first | (result.nullable ? other.first : 0),
+            other.last | (other.nullable ? result.last : 0)
+          };
+        }
+        return result;
+      }
+
+      constexpr Fragment parseRepetition(){
+        Fragment result = parseAtom();
+        while(!isAtEnd() && (pattern[index] == '*' || pattern[index] == '+' || pattern[index] == '?')){
+          char op = pattern[index++];
+          if(op != '?'){
+            addFollow(result.last, result.first);
+          }
+          if(op != '+'){
+            result.nullable = true;
+          }
+        }
+        return result;
+      }
+
+      constexpr Fragment parseAtom(){
+        char letter = pattern[index++];
+        if(letter == '('){
+          Fragment result = parseAlternation();
+          require(!isAtEnd() && pattern[index] == ')', "missing ')' in the regular expression");
+          index++;
+          return result;
+        }
+        require(letter != '*' && letter != '+' && letter != '?', "nothing to repeat in the regular expression");
+
+        std::array<bool, 256> accepted{};
+        if(letter == '.'){
+          for(auto &it : accepted){
+            it = true;
+          }
+        }else if(letter == '['){
+          parseClass(accepted);
+        }else if(letter == '\\'){
+          require(!isAtEnd(), "escape at the end of the regular expression");
+          parseEscape(pattern[index++], accepted);
+        }else{
+          accepted[static_cast<unsigned char>(letter)] = true;
+        }
+
+        require(positions < MaxPositions, "too many letters in the regular expression");
+        std::uint64_t position = std::uint64_t(1) << positions++;
+        for(std::size_t l = 0; l < 256; l++){
+          if(accepted[l]){
+            letterMask[l] |= position;
+          }
+        }
+        return {false, position, position};
+      }
+
+      constexpr void parseClass(std::array<bool, 256>& accepted){
+        bool negated = !isAtEnd() && pattern[index] == '^';
+        if(negated){
+          index++;
+        }
+        bool first = true;
+        while(!isAtEnd() && (pattern[index] != ']' || first)){
+          first = false;
+          char low = pattern[index++];
+          if(low == '\\'){
+            require(!isAtEnd(), "escape at the end of the regular expression");
+            parseEscape(pattern[index++], accepted);
+            continue;
+          }
+          char high = low;
+          if(index + 1 < pattern.size() && pattern[index] == '-' && pattern[index + 1] != ']'){
+            high = pattern[index + 1];
+            index += 2;
+          }
+          require(static_cast<unsigned char>(low) <= static_cast<unsigned char>(high), "reversed range in the regular expression");
+          for(unsigned l = static_cast<unsigned char>(low); l <= static_cast<unsigned char>(high); l++){
+            accepted[l] = true;
+          }
+        }
+        require(!isAtEnd(), "missing ']' in the regular expression");
+        index++;
+        if(negated){
+          for(auto &it : accepted){
+            it = !it;
+          }
+        }
+      }
+
+      static constexpr void parseEscape(char letter, std::array<bool, 256>& accepted){
+        if(letter == 'd'){
+          for(char l = '0'; l <= '9'; l++){
+            accepted[l] = true;
+          }
+        }else if(letter == 'w'){
+          for(std::size_t l = 0; l < 256; l++){
+            accepted[l] = accepted[l] || (l >= 'a' && l <= 'z') || (l >= 'A' && l <= 'Z') || (l >= '0' && l <= '9') || l == '_';
+          }
+        }else if(letter == 's'){
+          for(char l : {' ', '\t', '\n', '\r', '\f', '\v'}){
+            accepted[static_cast<unsigned char>(l)] = true;
+          }
+        }else{
+          accepted[static_cast<unsigned char>(letter)] = true;
+        }
+      }
+
+      constexpr void addFollow(std::uint64_t from, std::uint64_t to){
+        for(std::size_t p = 0; p < MaxPositions; p++){
+          if(from >> p & 1){
+            follow[p] |= to;
+          }
+        }
+      }
+    };
+
+    /**
+     * Keep the accessible states and merge the equivalent ones (Moore), the
+     * states that cannot reach a final state merging with the sink and the
+     * initial state becoming 0
+     */
+    constexpr StaticTable createMinimal(const StaticTable& description){
+      /* the states that cannot reach a final state lead to the sink */
+      std::array<bool, StaticTable::MaxStates> live{};
+      for(std::size_t state = 0; state < description.states; state++){
+        live[state] = description.finals[state];
+      }
+      for(bool changed = true; changed; ){
+        changed = false;
+        for(std::size_t state = 0; state < description.states; state++){
+          for(std::size_t c = 0; c < description.classes && !live[state]; c++){
+            int target = description.table[state][c];
+            if(target >= 0 && live[target]){
+              live[state] = true;
+              changed = true;
+            }
+          }
+        }
+      }
+      StaticTable table = description;
+      for(std::size_t state = 0; state < table.states; state++){
+        for(std::size_t c = 0; c < table.classes; c++){
+          int &target = table.table[state][c];
+          if(target >= 0 && !live[target]){
+            target = -1;
+          }
+        }
+      }
+
+      /* the accessible states, numbered in breadth-first order */
+      std::array<int, StaticTable::MaxStates> order{};
+      std::array<bool, StaticTable::MaxStates> seen{};
+      std::size_t states = 0;
+      order[states++] = table.initial;
+      seen[table.initial] = true;
+      for(std::size_t i = 0; i < states; i++){
+        for(std::size_t c = 0; c < table.classes; c++){
+          int target = table.table[order[i]][c];
+          if(target >= 0 && !seen[target]){
+            seen[target] = true;
+            order[states++] = target;
+          }
+        }
+      }
+
+      /* refine the classes of states until they are stable, -1 being the sink */
+      std::array<int, StaticTable::MaxStates> group{};
+      bool finals = false, others = false;
+      for(std::size_t i = 0; i < states; i++){
+        group[order[i]] = table.finals[order[i]] ? 1 : 0;
+        finals = finals || table.finals[order[i]];
+        others = others || !table.finals[order[i]];
+      }
+      std::size_t groups = finals + others;
+      for(bool changed = true; changed; ){
+        std::array<int, StaticTable::MaxStates> next{};
+        std::size_t count = 0;
+        for(std::size_t i = 0; i < states; i++){
+          int state = order[i];
+          std::size_t j = 0;
+          for(; j < i; j++){
+            int other = order[j];
+            bool same = group[state] == group[other];
+            for(std::size_t c = 0; c < table.classes && same; c++){
+              int lhs = table.table[state][c], rhs = table.table[other][c];
+              same = (lhs < 0 ? -1 : group[lhs]) == (rhs < 0 ? -1 : group[rhs]);
+            }
+            if(same){
+              break;
+            }
+          }
+          next[state] = j < i ? next[order[j]] : count++;
+        }
+        changed = count != groups;
+        groups = count;
+        group = next;
+      }
+
+      StaticTable result;
+      result.states = groups;
+      result.classes = table.classes;
+      result.initial = 0;
+      result.letterClass = table.letterClass;
+      for(std::size_t i = 0; i < states; i++){
+        int state = order[i];
+        result.finals[group[state]] = table.finals[state];
+        for(std::size_t c = 0; c < table.classes; c++){
+          int target = table.table[state][c];
+          result.table[group[state]][c] = target < 0 ? -1 : group[target];
+        }
+      }
+      return result;
+    }
+
+    /**
+     * Copy a table into an automaton of its exact size
+     */
+    template<std::size_t States, std::size_t Classes>
+    constexpr StaticAutomaton<States, Classes> createFromTable(const StaticTable& table){
+      StaticAutomaton<States, Classes> automaton;
+      automaton.initial = table.initial;
+      automaton.letterClass = table.letterClass;
+      for(std::size_t state = 0; state < States; state++){
+        automaton.finals[state] = table.finals[state];
+        for(std::size_t c = 0; c < Classes; c++){
+          int target = table.table[state][c];
+          automaton.table[state][c] = target < 0 ? StaticAutomaton<States, Classes>::Sink : target;
+        }
+      }
+      return automaton;
+    }
+  }
+
+  /**
+   * Create the minimal automaton of a description given as a static constexpr object, the states
+   * that cannot reach a final state being merged with the sink
+   *
+   *   static constexpr fa::StaticDescription<2, 2> Description = {0, {false, true}, {{{0, 'a', 1}, {1, 'a', 1}}}};
+   *   constexpr auto automaton = fa::createStaticAutomaton<Description>();
+   */
+  template<const auto& Description>
+  constexpr auto createStaticAutomaton(){
+    constexpr detail::StaticTable table = detail::createMinimal(detail::compileDescription(Description));
+    return detail::createFromTable<table.states, table.classes>(table);
+  }
+
+  /**
+   * Create the minimal automaton of a regular expression given as a static constexpr string, the states
+   * that cannot reach a final state being merged with the sink
+   *
+   *   static constexpr char Pattern[] = "[a-z]+(-[a-z]+)*";
+   *   constexpr auto automaton = fa::createStaticRegex<Pattern>();
+   */
+  template<const char* Pattern>
+  constexpr auto createStaticRegex(){
+    constexpr detail::StaticTable table = detail::createMinimal(detail::Glushkov(Pattern).createTable());
+    return detail::createFromTable<table.states, table.classes>(table);
+  }
+}
+
+#endif // STATIC_AUTOMATON_H
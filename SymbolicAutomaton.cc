@@ -0,0 +1,949 @@
+/**
+ * @file SymbolicAutomaton.cc
+ * @author Pierre Viprey
+ * @brief Management of automate labelled by sets of symbols
+ * @version 1.0
+ * @date 2026-10-19
+ *
+ */
+#include "SymbolicAutomaton.h"
+
+#include <climits>  // INT_MAX
+#include <queue>
+
+namespace fa {
+  /**
+   * @brief Construct an empty CharSet
+   *
+   */
+  CharSet::CharSet(){
+  }
+
+  /**
+   * @brief Construct a CharSet containing a single symbol
+   *
+   * @param symbol the symbol
+   */
+  CharSet::CharSet(char32_t symbol){
+    ranges.push_back({symbol, symbol});
+  }
+
+  /**
+   * @brief Construct a CharSet containing a range of symbols
+   *
+   * @param first the lowest symbol
+   * @param last the greatest symbol (included)
+   */
+  CharSet::CharSet(char32_t first, char32_t last){
+    add(first, last);
+  }
+
+  /**
+   * @brief add a range of symbols, the ranges stay sorted and are merged when they overlap or touch.
+   *
+   * @param first the lowest symbol
+   * @param last the greatest symbol (included)
+   */
+  void CharSet::add(char32_t first, char32_t last){
+    if(first > last){
+      return;
+    }
+
+    /* find the first range that can be merged with the new one */
+    auto it = std::lower_bound(ranges.begin(), ranges.end(), first, [](const Range& range, char32_t symbol){
+      return range.last + 1 < symbol;
+    });
+
+    /* absorb every range overlapping or touching the new one */
+    auto end = it;
+    while(end != ranges.end() && end->first <= last + 1){
+      first = std::min(first, end->first);
+      last = std::max(last, end->last);
+      ++end;
+    }
+    it = ranges.erase(it, end);
+    ranges.insert(it, {first, last});
+  }
+
+  /**
+   * @brief check if the set contains the symbol.
+   *
+   * @param symbol the symbol
+   * @return true (success)
+   * @return false (failure)
+   */
+  bool CharSet::contains(char32_t symbol) const{
+    auto it = std::lower_bound(ranges.begin(), ranges.end(), symbol, [](const Range& range, char32_t symbol){
+      return range.last < symbol;
+    });
+    return it != ranges.end() && it->first <= symbol;
+  }
+
+  /**
+   * @brief check if the set is empty.
+   *
+   * @return true (success)
+   * @return false (failure)
+   */
+  bool CharSet::isEmpty() const{
+    return ranges.empty();
+  }
+
+  /**
+   * @brief returns the number of symbols in the set.
+   *
+   * @return std::size_t
+   */
+  std::size_t CharSet::countSymbols() const{
+    std::size_t count = 0;
+    for(auto const &range : ranges){
+      count += range.last - range.first + 1;
+    }
+    return count;
+  }
+
+  /**
+   * @brief returns the ranges of the set.
+   *
+   * @return const std::vector<Range>&
+   */
+  const std::vector<Range>& CharSet::getRanges() const{
+    return ranges;
+  }
+
+  /**
+   * @brief create the union of two sets.
+   *
+   * @param lhs the first set
+   * @param rhs the second set
+   * @return CharSet
+   */
+  CharSet CharSet::createUnion(const CharSet& lhs, const CharSet& rhs){
+    CharSet set = lhs;
+    for(auto const &range : rhs.ranges){
+      set.add(range.first, range.last);
+    }
+    return set;
+  }
+
+  /**
+   * @brief create the intersection of two sets by walking both sorted lists of ranges.
+   *
+   * @param lhs the first set
+   * @param rhs the second set
+   * @return CharSet
+   */
+  CharSet CharSet::createIntersection(const CharSet& lhs, const CharSet& rhs){
+    CharSet set;
+    auto it_lhs = lhs.ranges.begin();
+    auto it_rhs = rhs.ranges.begin();
+    while(it_lhs != lhs.ranges.end() && it_rhs != rhs.ranges.end()){
+      char32_t first = std::max(it_lhs->first, it_rhs->first);
+      char32_t last = std::min(it_lhs->last, it_rhs->last);
+      if(first <= last){
+        set.ranges.push_back({first, last});
+      }
+      if(it_lhs->last < it_rhs->last){
+        ++it_lhs;
+      }else{
+        ++it_rhs;
+      }
+    }
+    return set;
+  }
+
+  /**
+   * @brief create the set of the symbols of lhs that are not in rhs.
+   *
+   * @param lhs the first set
+   * @param rhs the second set
+   * @return CharSet
+   */
+  CharSet CharSet::createDifference(const CharSet& lhs, const CharSet& rhs){
+    if(lhs.isEmpty()){
+      return lhs;
+    }
+    return createIntersection(lhs, createComplement(rhs, lhs.ranges.back().last));
+  }
+
+  /**
+   * @brief create the complement of a set in [0, max].
+   *
+   * @param set the set
+   * @param max the greatest symbol of the alphabet
+   * @return CharSet
+   */
+  CharSet CharSet::createComplement(const CharSet& set, char32_t max){
+    CharSet complement;
+    char32_t next = 0;
+    for(auto const &range : set.ranges){
+      if(range.first > max){
+        break;
+      }
+      if(range.first > next){
+        complement.ranges.push_back({next, range.first - 1});
+      }
+      next = range.last + 1;
+      if(range.last >= max){
+        return complement;
+      }
+    }
+    complement.ranges.push_back({next, max});
+    return complement;
+  }
+
+  bool CharSet::operator==(const CharSet& other) const{
+    if(ranges.size() != other.ranges.size()){
+      return false;
+    }
+    for(std::size_t i = 0; i < ranges.size(); i++){
+      if(ranges[i].first != other.ranges[i].first || ranges[i].last != other.ranges[i].last){
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool CharSet::operator!=(const CharSet& other) const{
+    return !(*this == other);
+  }
+
+  /**
+   * @brief print a set of symbols as a character class.
+   *
+   * @param os the stream
+   * @param set the set
+   */
+  static void printCharSet(std::ostream& os, const CharSet& set){
+    auto printSymbol = [&os](char32_t symbol){
+      if(symbol < 0x80 && isgraph(static_cast<int>(symbol))){
+        os << static_cast<char>(symbol);
+      }else{
+        os << "\\x" << std::hex << static_cast<unsigned long>(symbol) << std::dec;
+      }
+    };
+
+    os << "[";
+    for(auto const &range : set.getRanges()){
+      printSymbol(range.first);
+      if(range.first != range.last){
+        os << "-";
+        printSymbol(range.last);
+      }
+    }
+    os << "]";
+  }
+
+  /**
+   * @brief Construct a new SymbolicAutomaton object
+   *
+   * @param encoding the encoding of the words
+   */
+  SymbolicAutomaton::SymbolicAutomaton(Encoding encoding)
+  : encoding(encoding), nextNumber(0){
+  }
+
+  /**
+   * @brief test if the automate is valid.
+   * (ie: has at least one state, the alphabet is given by the encoding)
+   *
+   * @return true (success)
+   * @return false (failure)
+   */
+  bool SymbolicAutomaton::isValid() const{
+    return !node.empty();
+  }
+
+  /**
+   * @brief returns the encoding of the words.
+   *
+   * @return Encoding
+   */
+  Encoding SymbolicAutomaton::getEncoding() const{
+    return encoding;
+  }
+
+  /**
+   * @brief returns the greatest symbol of the alphabet.
+   *
+   * @return char32_t
+   */
+  char32_t SymbolicAutomaton::getMaxSymbol() const{
+    return encoding == Encoding::Byte ? MaxByte : MaxCodePoint;
+  }
+
+  /**
+   * @brief add a state to the automate.
+   *
+   * @param state the index of the state
+   * @return true (success)
+   * @return false (failure)
+   */
+  bool SymbolicAutomaton::addState(int state){
+    if(state >= 0){
+      auto rtn = node.insert({state, {false, false}});
+      if(rtn.second && state >= nextNumber){
+        nextNumber = state == INT_MAX ? INT_MAX : state + 1;
+      }
+      return rtn.second;
+    }
+    return false;
+  }
+
+  /**
+   * @brief return a number available for a new state, greater than every number in use
+   * unless the greatest number is taken, in which case the unused numbers are searched
+   * downward.
+   *
+   * @return number (success)
+   * @return -1 (failure)
+   */
+  int SymbolicAutomaton::getNumberForNewNode() const{
+    if(!hasState(nextNumber)){
+      return nextNumber;
+    }
+    for(int number = nextNumber; number >= 0; number--){
+      if(!hasState(number)){
+        return number;
+      }
+    }
+    return -1;
+  }
+
+  /**
+   * @brief check if the automate contains the given state.
+   *
+   * @param state the index of the state
+   * @return true (success)
+   * @return false (failure)
+   */
+  bool SymbolicAutomaton::hasState(int state) const{
+    return node.find(state) != node.end();
+  }
+
+  /**
+   * @brief returns the number of states in the automate.
+   *
+   * @return std::size_t
+   */
+  std::size_t SymbolicAutomaton::countStates() const{
+    return node.size();
+  }
+
+  /**
+   * @brief set the state as initial.
+   *
+   * @param state the index of the state
+   */
+  void SymbolicAutomaton::setStateInitial(int state){
+    auto position = node.find(state);
+    if(position != node.end()){
+      position->second.initial = true;
+    }
+  }
+
+  /**
+   * @brief check if the state is initial.
+   *
+   * @param state the index of the state
+   * @return true (success)
+   * @return false (failure)
+   */
+  bool SymbolicAutomaton::isStateInitial(int state) const{
+    auto position = node.find(state);
+    return position != node.end() && position->second.initial;
+  }
+
+  /**
+   * @brief set the state as final.
+   *
+   * @param state the index of the state
+   */
+  void SymbolicAutomaton::setStateFinal(int state){
+    auto position = node.find(state);
+    if(position != node.end()){
+      position->second.final = true;
+    }
+  }
+
+  /**
+   * @brief check if the state is final.
+   *
+   * @param state the index of the state
+   * @return true (success)
+   * @return false (failure)
+   */
+  bool SymbolicAutomaton::isStateFinal(int state) const{
+    auto position = node.find(state);
+    return position != node.end() && position->second.final;
+  }
+
+  /**
+   * @brief add a transition to the automate, merging the label with an existing
+   * transition between the same states.
+   *
+   * @param from the index of the origin of the transition
+   * @param label the symbols of the transition
+   * @param to the index of the arrival of the transition
+   * @return true (success)
+   * @return false (failure)
+   */
+  bool SymbolicAutomaton::addTransition(int from, const CharSet& label, int to){
+    if(!hasState(from) || !hasState(to)){
+      return false;
+    }
+    if(label.isEmpty() || label.getRanges().back().last > getMaxSymbol()){
+      return false;
+    }
+
+    auto position = transition.equal_range(from);
+    for(auto it = position.first; it != position.second; it++){
+      if(it->second.target == to){
+        it->second.label = CharSet::createUnion(it->second.label, label);
+        return true;
+      }
+    }
+
+    transition.insert({from, {label, to}});
+    return true;
+  }
+
+  /**
+   * @brief check if the symbol leads from a state to another.
+   *
+   * @param from the index of the origin of the transition
+   * @param symbol the symbol
+   * @param to the index of the arrival of the transition
+   * @return true (success)
+   * @return false (failure)
+   */
+  bool SymbolicAutomaton::hasTransition(int from, char32_t symbol, int to) const{
+    auto position = transition.equal_range(from);
+    for(auto it = position.first; it != position.second; it++){
+      if(it->second.target == to && it->second.label.contains(symbol)){
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief returns the number of transition in the automate
+   *
+   * @return std::size_t
+   */
+  std::size_t SymbolicAutomaton::countTransitions() const{
+    return transition.size();
+  }
+
+  /**
+   * @brief print the automate.
+   *
+   * @param os the stream to input the automate
+   */
+  void SymbolicAutomaton::prettyPrint(std::ostream& os) const{
+    os << "Initial states:" << std::endl;
+    for(auto const &it : node){
+      if(it.second.initial){
+        os << "\t" << it.first;
+      }
+    }
+    os << std::endl;
+
+    os << "Final states:" << std::endl;
+    for(auto const &it : node){
+      if(it.second.final){
+        os << "\t" << it.first;
+      }
+    }
+    os << "\n" << std::endl;
+
+    os << "Transition:" << std::endl;
+    for(auto const &it : node){
+      auto position = transition.equal_range(it.first);
+      if(position.first == position.second){
+        continue;
+      }
+      os << "\tFor state " << it.first << ":" << std::endl;
+      for(auto c = position.first; c != position.second; c++){
+        os << "\t\t" << "--";
+        printCharSet(os, c->second.label);
+        os << "--> " << c->second.target << std::endl;
+      }
+    }
+  }
+
+  /**
+   * @brief check if the automate is deterministic.
+   * (ie: a single initial state and the labels leaving a state are disjoint)
+   *
+   * @return true (success)
+   * @return false (failure)
+   */
+  bool SymbolicAutomaton::isDeterministic() const{
+    assert(isValid());
+
+    std::size_t initial = 0;
+    for(auto const &it : node){
+      if(it.second.initial){
+        initial++;
+      }
+    }
+    if(initial != 1){
+      return false;
+    }
+
+    for(auto const &it : node){
+      std::vector<Range> ranges;
+      auto position = transition.equal_range(it.first);
+      for(auto c = position.first; c != position.second; c++){
+        ranges.insert(ranges.end(), c->second.label.getRanges().begin(), c->second.label.getRanges().end());
+      }
+      std::sort(ranges.begin(), ranges.end(), [](const Range& lhs, const Range& rhs){
+        return lhs.first < rhs.first;
+      });
+      for(std::size_t i = 1; i < ranges.size(); i++){
+        if(ranges[i].first <= ranges[i - 1].last){
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief check if the automate is complete.
+   * (ie: every symbol of the alphabet leaves every state)
+   *
+   * @return true (success)
+   * @return false (failure)
+   */
+  bool SymbolicAutomaton::isComplete() const{
+    assert(isValid());
+
+    const CharSet all(0, getMaxSymbol());
+    for(auto const &it : node){
+      CharSet out;
+      auto position = transition.equal_range(it.first);
+      for(auto c = position.first; c != position.second; c++){
+        out = CharSet::createUnion(out, c->second.label);
+      }
+      if(out != all){
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief decode a word into symbols.
+   *
+   * @param word the word
+   * @param encoding the encoding of the word
+   * @param symbols the decoded symbols
+   * @return true (success)
+   * @return false (the word is not well-formed)
+   */
+  bool SymbolicAutomaton::decode(const std::string& word, Encoding encoding, std::u32string& symbols){
+    symbols.clear();
+    if(encoding == Encoding::Byte){
+      for(unsigned char c : word){
+        symbols.push_back(c);
+      }
+      return true;
+    }
+
+    for(std::size_t i = 0; i < word.size(); ){
+      unsigned char c = word[i];
+      std::size_t length;
+      char32_t symbol, min;
+      if(c < 0x80){
+        length = 1; symbol = c; min = 0;
+      }else if((c & 0xE0) == 0xC0){
+        length = 2; symbol = c & 0x1F; min = 0x80;
+      }else if((c & 0xF0) == 0xE0){
+        length = 3; symbol = c & 0x0F; min = 0x800;
+      }else if((c & 0xF8) == 0xF0){
+        length = 4; symbol = c & 0x07; min = 0x10000;
+      }else{
+        return false;
+      }
+      if(i + length > word.size()){
+        return false;
+      }
+      for(std::size_t j = 1; j < length; j++){
+        unsigned char next = word[i + j];
+        if((next & 0xC0) != 0x80){
+          return false;
+        }
+        symbol = (symbol << 6) | (next & 0x3F);
+      }
+      /* reject the overlong forms, the surrogates and the out of range code points */
+      if(symbol < min || symbol > MaxCodePoint || (symbol >= 0xD800 && symbol <= 0xDFFF)){
+        return false;
+      }
+      symbols.push_back(symbol);
+      i += length;
+    }
+    return true;
+  }
+
+  /**
+   * @brief check if the word is in the language of the automate
+   *
+   * @param word the word to pass
+   * @return true (success)
+   * @return false (failure)
+   */
+  bool SymbolicAutomaton::match(const std::string& word) const{
+    std::u32string symbols;
+    if(!decode(word, encoding, symbols)){
+      return false;
+    }
+    return match(symbols);
+  }
+
+  /**
+   * @brief check if the decoded word is in the language of the automate
+   *
+   * @param word the symbols to pass
+   * @return true (success)
+   * @return false (failure)
+   */
+  bool SymbolicAutomaton::match(const std::u32string& word) const{
+    assert(isValid());
+
+    StateSet current;
+    for(auto const &it : node){
+      if(it.second.initial){
+        current.insert(it.first);
+      }
+    }
+
+    StateSet next;
+    for(char32_t symbol : word){
+      next.clear();
+      for(int state : current){
+        auto position = transition.equal_range(state);
+        for(auto it = position.first; it != position.second; it++){
+          if(it->second.label.contains(symbol)){
+            next.insert(it->second.target);
+          }
+        }
+      }
+      if(next.empty()){
+        return false;
+      }
+      std::swap(current, next);
+    }
+
+    for(int state : current){
+      if(isStateFinal(state)){
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief split the labels into minterms with a sweep over the bounds of the ranges.
+   * Every minterm is the union of the symbols reaching the same set of targets.
+   *
+   * @param links the transitions to split
+   * @return std::vector<std::pair<CharSet, std::vector<int>>> the minterms and their sorted targets
+   */
+  std::vector<std::pair<CharSet, std::vector<int>>> SymbolicAutomaton::createMinterms(const std::vector<SymbolicLink>& links){
+    /* <bound, <target, +1 when a range begins / -1 when it ends>> */
+    std::vector<std::pair<char32_t, std::pair<int, int>>> events;
+    for(auto const &link : links){
+      for(auto const &range : link.label.getRanges()){
+        events.push_back({range.first, {link.target, 1}});
+        events.push_back({range.last + 1, {link.target, -1}});
+      }
+    }
+    std::sort(events.begin(), events.end(), [](const auto& lhs, const auto& rhs){
+      return lhs.first < rhs.first;
+    });
+
+    std::vector<std::pair<CharSet, std::vector<int>>> minterms;
+    std::map<std::vector<int>, std::size_t> known;
+    std::map<int, int> active;
+    for(std::size_t i = 0; i < events.size(); ){
+      char32_t bound = events[i].first;
+      for(; i < events.size() && events[i].first == bound; i++){
+        auto it = active.insert({events[i].second.first, 0}).first;
+        it->second += events[i].second.second;
+        if(it->second == 0){
+          active.erase(it);
+        }
+      }
+      if(active.empty() || i == events.size()){
+        continue;
+      }
+
+      /* the symbols in [bound, next bound - 1] reach the active targets */
+      std::vector<int> targets;
+      for(auto const &it : active){
+        targets.push_back(it.first);
+      }
+      auto key = known.find(targets);
+      if(key == known.end()){
+        key = known.insert({targets, minterms.size()}).first;
+        minterms.push_back({CharSet(), targets});
+      }
+      minterms[key->second].first.add(bound, events[i].first - 1);
+    }
+    return minterms;
+  }
+
+  /**
+   * @brief create a complete automate from a given automate, the missing symbols
+   * of every state lead to a sink state
+   *
+   * @param automaton the automate
+   * @return SymbolicAutomaton
+   */
+  SymbolicAutomaton SymbolicAutomaton::createComplete(const SymbolicAutomaton& automaton){
+    assert(automaton.isValid());
+
+    if(automaton.isComplete()){
+      return automaton;
+    }
+
+    fa::SymbolicAutomaton complete = automaton;
+    int sink = complete.getNumberForNewNode();
+    assert(sink >= 0);
+    complete.addState(sink);
+
+    const CharSet all(0, complete.getMaxSymbol());
+    for(auto const &it : complete.node){
+      CharSet out;
+      auto position = complete.transition.equal_range(it.first);
+      for(auto c = position.first; c != position.second; c++){
+        out = CharSet::createUnion(out, c->second.label);
+      }
+      CharSet missing = CharSet::createDifference(all, out);
+      if(!missing.isEmpty()){
+        complete.transition.insert({it.first, {missing, sink}});
+      }
+    }
+    return complete;
+  }
+
+  /**
+   * @brief create the deterministic version of the automate, the subsets are
+   * explored over the minterms of the transitions leaving them
+   *
+   * @param automaton the automate
+   * @return SymbolicAutomaton
+   */
+  SymbolicAutomaton SymbolicAutomaton::createDeterministic(const SymbolicAutomaton& automaton){
+    assert(automaton.isValid());
+
+    fa::SymbolicAutomaton deterministic(automaton.encoding);
+
+    std::unordered_map<StateSet, int> nodes;
+    std::queue<std::pair<StateSet, int>> pending;
+    auto getNode = [&](const StateSet& subset){
+      auto key = nodes.find(subset);
+      if(key != nodes.end()){
+        return key->second;
+      }
+      int n = nodes.size();
+      nodes[subset] = n;
+      deterministic.addState(n);
+      for(int state : subset){
+        if(automaton.isStateFinal(state)){
+          deterministic.setStateFinal(n);
+          break;
+        }
+      }
+      pending.push({subset, n});
+      return n;
+    };
+
+    StateSet initial;
+    for(auto const &it : automaton.node){
+      if(it.second.initial){
+        initial.insert(it.first);
+      }
+    }
+    deterministic.setStateInitial(getNode(initial));
+
+    while(!pending.empty()){
+      auto current = pending.front();
+      pending.pop();
+
+      std::vector<SymbolicLink> links;
+      for(int state : current.first){
+        auto position = automaton.transition.equal_range(state);
+        for(auto it = position.first; it != position.second; it++){
+          links.push_back(it->second);
+        }
+      }
+
+      StateSet subset;
+      for(auto const &minterm : createMinterms(links)){
+        subset.assign(minterm.second.data(), minterm.second.data() + minterm.second.size());
+        int target = getNode(subset);
+        deterministic.addTransition(current.second, minterm.first, target);
+      }
+    }
+
+    return deterministic;
+  }
+
+  /**
+   * @brief create the synchronise product of two automates, the labels of the
+   * transitions are intersected
+   *
+   * @param lhs the first automate
+   * @param rhs the second automate
+   * @return SymbolicAutomaton
+   */
+  SymbolicAutomaton SymbolicAutomaton::createProduct(const SymbolicAutomaton& lhs, const SymbolicAutomaton& rhs){
+    assert(lhs.isValid());
+    assert(rhs.isValid());
+    assert(lhs.encoding == rhs.encoding);
+
+    fa::SymbolicAutomaton product(lhs.encoding);
+
+    std::map<std::pair<int, int>, int> nodes;
+    std::queue<std::pair<int, int>> pending;
+    auto getNode = [&](int node_lhs, int node_rhs){
+      auto key = nodes.find({node_lhs, node_rhs});
+      if(key != nodes.end()){
+        return key->second;
+      }
+      int n = nodes.size();
+      nodes[{node_lhs, node_rhs}] = n;
+      product.addState(n);
+      if(lhs.isStateFinal(node_lhs) && rhs.isStateFinal(node_rhs)){
+        product.setStateFinal(n);
+      }
+      pending.push({node_lhs, node_rhs});
+      return n;
+    };
+
+    for(auto const &it_lhs : lhs.node){
+      for(auto const &it_rhs : rhs.node){
+        if(it_lhs.second.initial && it_rhs.second.initial){
+          product.setStateInitial(getNode(it_lhs.first, it_rhs.first));
+        }
+      }
+    }
+
+    while(!pending.empty()){
+      auto current = pending.front();
+      pending.pop();
+      int from = nodes[current];
+
+      auto position_lhs = lhs.transition.equal_range(current.first);
+      auto position_rhs = rhs.transition.equal_range(current.second);
+      for(auto it_lhs = position_lhs.first; it_lhs != position_lhs.second; it_lhs++){
+        for(auto it_rhs = position_rhs.first; it_rhs != position_rhs.second; it_rhs++){
+          CharSet label = CharSet::createIntersection(it_lhs->second.label, it_rhs->second.label);
+          if(!label.isEmpty()){
+            product.addTransition(from, label, getNode(it_lhs->second.target, it_rhs->second.target));
+          }
+        }
+      }
+    }
+
+    /* make the automaton valid if needed */
+    if(!product.isValid()){
+      product.addState(0);
+      product.setStateInitial(0);
+    }
+
+    return product;
+  }
+
+  /**
+   * @brief create the minimal version of the automate using the Moore algorithm,
+   * the letters are the minterms of all the labels of the complete DFA
+   *
+   * @param automaton the automate
+   * @return SymbolicAutomaton
+   */
+  SymbolicAutomaton SymbolicAutomaton::createMinimalMoore(const SymbolicAutomaton& automaton){
+    assert(automaton.isValid());
+
+    /* the states of the DFA are numbered from 0 and all accessible */
+    fa::SymbolicAutomaton dfa = createComplete(createDeterministic(automaton));
+    std::map<int, std::size_t> index;
+    std::vector<int> states;
+    for(auto const &it : dfa.node){
+      index[it.first] = states.size();
+      states.push_back(it.first);
+    }
+
+    /* every transition gets its own target so that the minterms are the classes of symbols */
+    std::vector<SymbolicLink> links;
+    std::vector<std::size_t> origins, targets;
+    for(auto const &it : dfa.transition){
+      links.push_back({it.second.label, (int)links.size()});
+      origins.push_back(index[it.first]);
+      targets.push_back(index[it.second.target]);
+    }
+    auto minterms = createMinterms(links);
+
+    /* delta[state][minterm] = target, every state has exactly one transition per minterm */
+    std::vector<std::vector<std::size_t>> delta(states.size(), std::vector<std::size_t>(minterms.size()));
+    for(std::size_t m = 0; m < minterms.size(); m++){
+      for(int link : minterms[m].second){
+        delta[origins[link]][m] = targets[link];
+      }
+    }
+
+    std::vector<int> moore(states.size()), mooreBis;
+    for(std::size_t s = 0; s < states.size(); s++){
+      moore[s] = dfa.isStateFinal(states[s]) ? 1 : 0;
+    }
+
+    std::size_t classes = 0;
+    while(true){
+      std::map<std::vector<int>, int> signatures;
+      mooreBis.assign(states.size(), 0);
+      for(std::size_t s = 0; s < states.size(); s++){
+        std::vector<int> key;
+        key.push_back(moore[s]);
+        for(std::size_t m = 0; m < minterms.size(); m++){
+          key.push_back(moore[delta[s][m]]);
+        }
+        auto it = signatures.insert({key, (int)signatures.size()}).first;
+        mooreBis[s] = it->second;
+      }
+      moore.swap(mooreBis);
+      if(signatures.size() == classes){
+        break;
+      }
+      classes = signatures.size();
+    }
+
+    fa::SymbolicAutomaton minimal(automaton.encoding);
+    std::vector<bool> done(classes, false);
+    for(std::size_t s = 0; s < states.size(); s++){
+      int c = moore[s];
+      minimal.addState(c);
+      if(dfa.isStateInitial(states[s])){
+        minimal.setStateInitial(c);
+      }
+      if(dfa.isStateFinal(states[s])){
+        minimal.setStateFinal(c);
+      }
+    }
+    for(std::size_t s = 0; s < states.size(); s++){
+      int c = moore[s];
+      if(done[c]){
+        continue;
+      }
+      done[c] = true;
+      for(std::size_t m = 0; m < minterms.size(); m++){
+        minimal.addTransition(c, minterms[m].first, moore[delta[s][m]]);
+      }
+    }
+
+    return minimal;
+  }
+}
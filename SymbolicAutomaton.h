@@ -0,0 +1,245 @@
+#ifndef SYMBOLIC_AUTOMATON_H
+#define SYMBOLIC_AUTOMATON_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+#include <map>            // needed for the good working of std::map
+#include <vector>         // needed for the good working of std::vector
+
+#include <cassert>        // assert
+
+#include "Automaton.h"    // fa::State
+#include "StateSet.h"     // fa::StateSet
+
+namespace fa {
+  /**
+   * Greatest symbol of a byte alphabet and of a Unicode alphabet
+   */
+  constexpr char32_t MaxByte = 0xFF;
+  constexpr char32_t MaxCodePoint = 0x10FFFF;
+
+  /**
+   * How the words given to a symbolic automaton are decoded
+   */
+  enum class Encoding{
+    Byte,   // every byte of the string is a symbol in [0, 255]
+    Utf8    // the string is decoded as UTF-8, every code point is a symbol
+  };
+
+  /**
+   * A closed interval of symbols
+   */
+  struct Range{
+    char32_t first, last;
+  };
+
+  /**
+   * A set of symbols stored as sorted, disjoint and non-adjacent ranges
+   */
+  class CharSet {
+  public:
+    /**
+     * Build an empty set
+     */
+    CharSet();
+
+    /**
+     * Build the set containing only the symbol
+     */
+    CharSet(char32_t symbol);
+
+    /**
+     * Build the set containing every symbol between first and last (included)
+     */
+    CharSet(char32_t first, char32_t last);
+
+    /**
+     * Add every symbol between first and last (included)
+     */
+    void add(char32_t first, char32_t last);
+
+    /**
+     * Tell if the symbol is in the set
+     */
+    bool contains(char32_t symbol) const;
+
+    /**
+     * Tell if the set has no symbol
+     */
+    bool isEmpty() const;
+
+    /**
+     * Count the number of symbols in the set
+     */
+    std::size_t countSymbols() const;
+
+    /**
+     * Get the ranges of the set, sorted and disjoint
+     */
+    const std::vector<Range>& getRanges() const;
+
+    /**
+     * Create the union, the intersection and the difference of two sets
+     */
+    static CharSet createUnion(const CharSet& lhs, const CharSet& rhs);
+    static CharSet createIntersection(const CharSet& lhs, const CharSet& rhs);
+    static CharSet createDifference(const CharSet& lhs, const CharSet& rhs);
+
+    /**
+     * Create the complement of the set in [0, max]
+     */
+    static CharSet createComplement(const CharSet& set, char32_t max);
+
+    bool operator==(const CharSet& other) const;
+    bool operator!=(const CharSet& other) const;
+
+  private:
+    std::vector<Range> ranges;
+  };
+
+  struct SymbolicLink{
+    CharSet label;
+    int target;
+  };
+
+  /**
+   * An automaton whose transitions are labelled by sets of symbols.
+   *
+   * The alphabet is every symbol of the encoding (bytes or Unicode code points),
+   * so character classes are stored as a single transition.
+   */
+  class SymbolicAutomaton {
+  public:
+    /**
+     * Build an empty automaton reading words in the given encoding
+     */
+    explicit SymbolicAutomaton(Encoding encoding = Encoding::Byte);
+
+    /**
+     * Tell if an automaton is valid.
+     *
+     * A valid automaton has a non-empty set of states
+     */
+    bool isValid() const;
+
+    /**
+     * Get the encoding and the greatest symbol of the alphabet
+     */
+    Encoding getEncoding() const;
+    char32_t getMaxSymbol() const;
+
+    /**
+     * Add a state to the automaton.
+     *
+     * Returns true if the state was effectively added and false otherwise.
+     */
+    bool addState(int state);
+
+    /**
+     * Tell if the state is present in the automaton.
+     */
+    bool hasState(int state) const;
+
+    /**
+     * Compute the number of states.
+     */
+    std::size_t countStates() const;
+
+    /**
+     * Set the state initial / final and tell if it is
+     */
+    void setStateInitial(int state);
+    bool isStateInitial(int state) const;
+    void setStateFinal(int state);
+    bool isStateFinal(int state) const;
+
+    /**
+     * Add a transition labelled by a set of symbols
+     *
+     * If a transition already exists between the two states, the labels are merged.
+     * Returns false if one of the state does not exist or if the label is empty
+     * or out of the alphabet.
+     */
+    bool addTransition(int from, const CharSet& label, int to);
+
+    /**
+     * Tell if the symbol leads from a state to another.
+     */
+    bool hasTransition(int from, char32_t symbol, int to) const;
+
+    /**
+     * Compute the number of transitions (one per labelled edge)
+     */
+    std::size_t countTransitions() const;
+
+    /**
+     * Print the automaton in a friendly way
+     */
+    void prettyPrint(std::ostream& os) const;
+
+    /**
+     * Tell if the automaton is deterministic / complete
+     */
+    bool isDeterministic() const;
+    bool isComplete() const;
+
+    /**
+     * Tell if the word is in the language accepted by the automaton
+     *
+     * A word that is not well-formed in the encoding is rejected.
+     */
+    bool match(const std::string& word) const;
+    bool match(const std::u32string& word) const;
+
+    /**
+     * Decode a word with respect to the encoding
+     *
+     * Returns false if the word is not well-formed.
+     */
+    static bool decode(const std::string& word, Encoding encoding, std::u32string& symbols);
+
+    /**
+     * Create a complete automaton, if not already complete
+     */
+    static SymbolicAutomaton createComplete(const SymbolicAutomaton& automaton);
+
+    /**
+     * Create a deterministic automaton, the subsets are split over the minterms of their labels
+     */
+    static SymbolicAutomaton createDeterministic(const SymbolicAutomaton& automaton);
+
+    /**
+     * Create the product of two automata reading the same encoding
+     */
+    static SymbolicAutomaton createProduct(const SymbolicAutomaton& lhs, const SymbolicAutomaton& rhs);
+
+    /**
+     * Create an equivalent minimal automaton with the Moore algorithm over the minterms
+     */
+    static SymbolicAutomaton createMinimalMoore(const SymbolicAutomaton& automaton);
+
+  private:
+    /**
+     * The structure of our automaton
+     */
+    Encoding encoding;
+    std::map<int, State> node;
+    std::multimap<int, SymbolicLink> transition;
+    int nextNumber;
+
+    /**
+     * Get a number available for a new state, -1 if every number is taken
+     */
+    int getNumberForNewNode() const;
+
+    /**
+     * Split the labels of the transitions into the minterms (classes of symbols that
+     * lead to the same set of targets), each minterm is given with its targets
+     */
+    static std::vector<std::pair<CharSet, std::vector<int>>> createMinterms(const std::vector<SymbolicLink>& links);
+  };
+}
+
+#endif // SYMBOLIC_AUTOMATON_H
@@ -0,0 +1,654 @@
+#include "benchmark/benchmark.h"
+#include "Automaton.h"
+#include "BlowUp.h"
+#include "Enumerator.h"
+#include "Sampler.h"
+#include "StaticAutomaton.h"
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+/*
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Those generators build the automata measured by the benchmarks            *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+ * An automaton over the letters 'a', 'b', ... with the given number of letters
+ */
+static fa::Automaton createWithAlphabet(int letters){
+  fa::Automaton fa;
+  for(int l = 0; l < letters; l++){
+    fa.addSymbol('a' + l);
+  }
+  return fa;
+}
+
+/**
+ * A random NFA, every state has on average 'degree' transitions per letter
+ */
+static fa::Automaton createRandomNfa(int states, int letters, int degree, unsigned seed){
+  std::mt19937 random(seed);
+  std::uniform_int_distribution<int> node(0, states - 1);
+  std::bernoulli_distribution final(0.1);
+
+  fa::Automaton fa = createWithAlphabet(letters);
+  for(int i = 0; i < states; i++){
+    fa.addState(i);
+    if(final(random)){
+      fa.setStateFinal(i);
+    }
+  }
+  fa.setStateInitial(0);
+  for(int i = 0; i < states; i++){
+    for(int l = 0; l < letters; l++){
+      for(int d = 0; d < degree; d++){
+        fa.addTransition(i, 'a' + l, node(random));
+      }
+    }
+  }
+  return fa;
+}
+
+/**
+ * A random complete DFA
+ */
+static fa::Automaton createRandomDfa(int states, int letters, unsigned seed){
+  return createRandomNfa(states, letters, 1, seed);
+}
+
+/**
+ * A chain of states reading a^(states-1)
+ */
+static fa::Automaton createChain(int states){
+  fa::Automaton fa = createWithAlphabet(2);
+  for(int i = 0; i < states; i++){
+    fa.addState(i);
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(states - 1);
+  for(int i = 0; i + 1 < states; i++){
+    fa.addTransition(i, 'a', i + 1);
+  }
+  return fa;
+}
+
+/**
+ * Every state goes to every state with every letter
+ */
+static fa::Automaton createClique(int states, int letters){
+  fa::Automaton fa = createWithAlphabet(letters);
+  for(int i = 0; i < states; i++){
+    fa.addState(i);
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(states - 1);
+  for(int i = 0; i < states; i++){
+    for(int j = 0; j < states; j++){
+      for(int l = 0; l < letters; l++){
+        fa.addTransition(i, 'a' + l, j);
+      }
+    }
+  }
+  return fa;
+}
+
+/**
+ * The Thompson construction of a regular expression made of letters, '|', '*', '+',
+ * '?' and parentheses. The NFA has epsilon transitions.
+ */
+class Thompson{
+public:
+  explicit Thompson(const std::string& regex)
+  : regex(regex), position(0), next(0){
+    for(char letter : regex){
+      if(isalnum(letter)){
+        fa.addSymbol(letter);
+      }
+    }
+    auto fragment = parseExpression();
+    fa.setStateInitial(fragment.first);
+    fa.setStateFinal(fragment.second);
+  }
+
+  fa::Automaton fa;
+
+private:
+  std::string regex;
+  std::size_t position;
+  int next;
+
+  int createState(){
+    fa.addState(next);
+    return next++;
+  }
+
+  /* expression := term ('|' term)* */
+  std::pair<int, int> parseExpression(){
+    auto fragment = parseTerm();
+    while(position < regex.size() && regex[position] == '|'){
+      position++;
+      auto other = parseTerm();
+      int begin = createState();
+      int end = createState();
+      fa.addTransition(begin, fa::Epsilon, fragment.first);
+      fa.addTransition(begin, fa::Epsilon, other.first);
+      fa.addTransition(fragment.second, fa::Epsilon, end);
+      fa.addTransition(other.second, fa::Epsilon, end);
+      fragment = {begin, end};
+    }
+    return fragment;
+  }
+
+  /* term := factor* */
+  std::pair<int, int> parseTerm(){
+    int begin = createState();
+    std::pair<int, int> fragment = {begin, begin};
+    while(position < regex.size() && regex[position] != '|' && regex[position] != ')'){
+      auto other = parseFactor();
+      fa.addTransition(fragment.second, fa::Epsilon, other.first);
+      fragment.second = other.second;
+    }
+    return fragment;
+  }
+
+  /* factor := atom ('*' | '+' | '?')* */
+  std::pair<int, int> parseFactor(){
+    auto fragment = parseAtom();
+    while(position < regex.size() && (regex[position] == '*' || regex[position] == '+' || regex[position] == '?')){
+      char op = regex[position++];
+      int begin = createState();
+      int end = createState();
+      fa.addTransition(begin, fa::Epsilon, fragment.first);
+      fa.addTransition(fragment.second, fa::Epsilon, end);
+      if(op != '+'){
+        fa.addTransition(begin, fa::Epsilon, end);
+      }
+      if(op != '?'){
+        fa.addTransition(fragment.second, fa::Epsilon, fragment.first);
+      }
+      fragment = {begin, end};
+    }
+    return fragment;
+  }
+
+  /* atom := '(' expression ')' | letter */
+  std::pair<int, int> parseAtom(){
+    if(regex[position] == '('){
+      position++;
+      auto fragment = parseExpression();
+      position++;   // ')'
+      return fragment;
+    }
+    int begin = createState();
+    int end = createState();
+    fa.addTransition(begin, regex[position++], end);
+    return {begin, end};
+  }
+};
+
+/**
+ * The Thompson NFA of (a|b)*c((a|b)*c)^k, it has about 10 states per repetition
+ */
+static fa::Automaton createThompson(int states){
+  std::string regex = "(a|b)*c";
+  for(int k = 10; k < states; k += 10){
+    regex += "(a|b)*c";
+  }
+  return Thompson(regex).fa;
+}
+
+/**
+ * A word of the given length over 'a' and 'b'
+ */
+static std::string createWord(std::size_t length, unsigned seed){
+  std::mt19937 random(seed);
+  std::string word(length, 'a');
+  for(auto &letter : word){
+    letter = 'a' + random() % 2;
+  }
+  return word;
+}
+
+static void setCounters(benchmark::State& state, const fa::Automaton& fa){
+  state.counters["states"] = fa.countStates();
+  state.counters["transitions"] = fa.countTransitions();
+}
+
+
+/*
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Those benchmarks measure the algorithms from 10^2 to 10^6 states          *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+static void BM_MatchDfa(benchmark::State& state){
+  fa::Automaton fa = createRandomDfa(state.range(0), 2, 1);
+  std::string word = createWord(1000, 2);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa.match(word));
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_MatchDfa)->RangeMultiplier(10)->Range(100, 1000000);
+
+static void BM_MatchNfa(benchmark::State& state){
+  fa::Automaton fa = createRandomNfa(state.range(0), 2, 3, 1);
+  std::string word = createWord(100, 2);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa.match(word));
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_MatchNfa)->RangeMultiplier(10)->Range(100, 1000000);
+
+static void BM_MatchChain(benchmark::State& state){
+  fa::Automaton fa = createChain(state.range(0));
+  std::string word(state.range(0) - 1, 'a');
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa.match(word));
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_MatchChain)->RangeMultiplier(10)->Range(100, 1000000);
+
+static void BM_MatchThompson(benchmark::State& state){
+  fa::Automaton fa = createThompson(state.range(0));
+  std::string word = createWord(1000, 2) + "c";
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa.match(word));
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_MatchThompson)->RangeMultiplier(10)->Range(100, 1000000);
+
+/* the same language (a|b)*a(a|b)^4, built at runtime or at compile time */
+static constexpr char BlowUpPattern[] = "(a|b)*a(a|b)(a|b)(a|b)(a|b)";
+
+static void BM_MatchBlowUpRuntime(benchmark::State& state){
+  fa::Automaton fa = fa::Automaton::createMinimalMoore(createBlowUp(4));
+  std::string word = createWord(state.range(0), 2);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa.match(word));
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_MatchBlowUpRuntime)->RangeMultiplier(10)->Range(100, 100000);
+
+static void BM_MatchBlowUpStatic(benchmark::State& state){
+  constexpr auto automaton = fa::createStaticRegex<BlowUpPattern>();
+  std::string word = createWord(state.range(0), 2);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(automaton.match(word));
+  }
+  state.counters["states"] = automaton.countStates();
+}
+BENCHMARK(BM_MatchBlowUpStatic)->RangeMultiplier(10)->Range(100, 100000);
+
+/* written by genfa from the minimal automaton of the same language */
+bool matchBlowUpGoto(std::string_view word);
+bool matchBlowUpSwitch(std::string_view word);
+
+static void BM_MatchBlowUpGeneratedGoto(benchmark::State& state){
+  std::string word = createWord(state.range(0), 2);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(matchBlowUpGoto(word));
+  }
+}
+BENCHMARK(BM_MatchBlowUpGeneratedGoto)->RangeMultiplier(10)->Range(100, 100000);
+
+static void BM_MatchBlowUpGeneratedSwitch(benchmark::State& state){
+  std::string word = createWord(state.range(0), 2);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(matchBlowUpSwitch(word));
+  }
+}
+BENCHMARK(BM_MatchBlowUpGeneratedSwitch)->RangeMultiplier(10)->Range(100, 100000);
+
+/* the range is n, the deterministic automaton has 2^(n+1) states */
+static void BM_DeterministicBlowUp(benchmark::State& state){
+  fa::Automaton fa = createBlowUp(state.range(0));
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa::Automaton::createDeterministic(fa));
+  }
+  setCounters(state, fa::Automaton::createDeterministic(fa));
+}
+BENCHMARK(BM_DeterministicBlowUp)->DenseRange(6, 19, 1);
+
+static void BM_DeterministicBlowUpParallel(benchmark::State& state){
+  fa::Automaton fa = createBlowUp(state.range(0));
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa::Automaton::createDeterministic(fa, 0));
+  }
+  setCounters(state, fa::Automaton::createDeterministic(fa, 0));
+}
+BENCHMARK(BM_DeterministicBlowUpParallel)->DenseRange(6, 19, 1);
+
+static void BM_DeterministicRandomNfa(benchmark::State& state){
+  fa::Automaton fa = createRandomNfa(state.range(0), 2, 2, 3);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa::Automaton::createDeterministic(fa));
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_DeterministicRandomNfa)->RangeMultiplier(2)->Range(8, 64);
+
+static void BM_DeterministicThompson(benchmark::State& state){
+  fa::Automaton fa = fa::Automaton::createWithoutEpsilon(createThompson(state.range(0)));
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa::Automaton::createDeterministic(fa));
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_DeterministicThompson)->RangeMultiplier(10)->Range(100, 1000000);
+
+/* the epsilon transitions followed by the subset construction, against removing them first */
+static void BM_DeterministicThompsonEpsilon(benchmark::State& state){
+  fa::Automaton fa = createThompson(state.range(0));
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa::Automaton::createDeterministic(fa));
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_DeterministicThompsonEpsilon)->RangeMultiplier(10)->Range(100, 1000000);
+
+static void BM_DeterministicThompsonWithoutEpsilon(benchmark::State& state){
+  fa::Automaton fa = createThompson(state.range(0));
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa::Automaton::createDeterministic(fa::Automaton::createWithoutEpsilon(fa)));
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_DeterministicThompsonWithoutEpsilon)->RangeMultiplier(10)->Range(100, 1000000);
+
+static void BM_MinimalMooreRandomDfa(benchmark::State& state){
+  fa::Automaton fa = createRandomDfa(state.range(0), 2, 4);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa::Automaton::createMinimalMoore(fa));
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_MinimalMooreRandomDfa)->RangeMultiplier(10)->Range(100, 1000000);
+
+static void BM_MinimalMooreRandomDfaParallel(benchmark::State& state){
+  fa::Automaton fa = createRandomDfa(state.range(0), 2, 4);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa::Automaton::createMinimalMoore(fa, 0));
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_MinimalMooreRandomDfaParallel)->RangeMultiplier(10)->Range(100, 1000000);
+
+static void BM_MinimalMooreChain(benchmark::State& state){
+  fa::Automaton fa = createChain(state.range(0));
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa::Automaton::createMinimalMoore(fa));
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_MinimalMooreChain)->RangeMultiplier(10)->Range(100, 1000000);
+
+/* the mirror of a random DFA usually explodes once deterministic, the chain does not */
+static void BM_MinimalBrzozowskiChain(benchmark::State& state){
+  fa::Automaton fa = createChain(state.range(0));
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa::Automaton::createMinimalBrzozowski(fa));
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_MinimalBrzozowskiChain)->RangeMultiplier(10)->Range(100, 1000000);
+
+static void BM_MinimalBrzozowskiBlowUp(benchmark::State& state){
+  fa::Automaton fa = createBlowUp(state.range(0));
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa::Automaton::createMinimalBrzozowski(fa));
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_MinimalBrzozowskiBlowUp)->DenseRange(6, 19, 1);
+
+/* the random DFA is complete, so the complement only swaps the final states */
+static void BM_ComplementRandomDfa(benchmark::State& state){
+  fa::Automaton fa = createRandomDfa(state.range(0), 2, 7);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa::Automaton::createComplement(fa));
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_ComplementRandomDfa)->RangeMultiplier(10)->Range(100, 1000000);
+
+static void BM_CountWordsRandomDfa(benchmark::State& state){
+  fa::Automaton fa = createRandomDfa(state.range(0), 2, 7);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa.countWords(1000));
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_CountWordsRandomDfa)->RangeMultiplier(10)->Range(100, 100000);
+
+/* the words of length 1000 drawn one by one, then a thousand at a time in one buffer */
+static void BM_SampleRandomDfa(benchmark::State& state){
+  fa::Automaton fa = createRandomDfa(state.range(0), 2, 7);
+  fa::WordSampler sampler(fa, 1000);
+  std::mt19937_64 random(3);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(sampler.sample(random));
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_SampleRandomDfa)->RangeMultiplier(10)->Range(100, 100000);
+
+static void BM_SampleBatchRandomDfa(benchmark::State& state){
+  fa::Automaton fa = createRandomDfa(state.range(0), 2, 7);
+  fa::WordSampler sampler(fa, 1000);
+  std::mt19937_64 random(3);
+  std::vector<char> buffer(1000 * 1000);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(sampler.sample(random, buffer.data(), 1000));
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+  setCounters(state, fa);
+}
+BENCHMARK(BM_SampleBatchRandomDfa)->RangeMultiplier(10)->Range(100, 100000);
+
+static void BM_SamplerRandomDfa(benchmark::State& state){
+  fa::Automaton fa = createRandomDfa(state.range(0), 2, 7);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa::WordSampler(fa, 1000));
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_SamplerRandomDfa)->RangeMultiplier(10)->Range(100, 10000);
+
+/* the first 100000 words in shortlex order, the state count changing the lengths reached */
+static void BM_EnumerateShortlexRandomDfa(benchmark::State& state){
+  fa::Automaton fa = createRandomDfa(state.range(0), 2, 7);
+  for(auto _ : state){
+    fa::WordEnumerator enumerator(fa);
+    for(int i = 0; i < 100000 && enumerator.next(); i++){
+      benchmark::DoNotOptimize(enumerator.getWord().data());
+    }
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_EnumerateShortlexRandomDfa)->RangeMultiplier(10)->Range(10, 10000);
+
+/* the 2^n words of length n over {a, b}, every one in lexicographic order */
+static void BM_EnumerateLexicographicAllWords(benchmark::State& state){
+  fa::Automaton fa;
+  fa.addSymbol('a');
+  fa.addSymbol('b');
+  for(int i = 0; i <= state.range(0); i++){
+    fa.addState(i);
+    if(i > 0){
+      fa.addTransition(i - 1, 'a', i);
+      fa.addTransition(i - 1, 'b', i);
+    }
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(state.range(0));
+  for(auto _ : state){
+    fa::WordEnumerator enumerator(fa, fa::WordOrder::Lexicographic);
+    while(enumerator.next()){
+      benchmark::DoNotOptimize(enumerator.getWord().data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * (std::int64_t(1) << state.range(0)));
+  setCounters(state, fa);
+}
+BENCHMARK(BM_EnumerateLexicographicAllWords)->DenseRange(12, 20, 4);
+
+/* the second automaton is small, the product has at most 8 times the states of the first one */
+static void BM_ProductRandomDfa(benchmark::State& state){
+  fa::Automaton lhs = createRandomDfa(state.range(0), 2, 5);
+  fa::Automaton rhs = createRandomDfa(8, 2, 6);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa::Automaton::createProduct(lhs, rhs));
+  }
+  setCounters(state, fa::Automaton::createProduct(lhs, rhs));
+}
+BENCHMARK(BM_ProductRandomDfa)->RangeMultiplier(10)->Range(100, 1000000);
+
+static void BM_ProductClique(benchmark::State& state){
+  fa::Automaton lhs = createClique(state.range(0), 2);
+  fa::Automaton rhs = createClique(state.range(0), 2);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa::Automaton::createProduct(lhs, rhs));
+  }
+  setCounters(state, lhs);
+}
+BENCHMARK(BM_ProductClique)->RangeMultiplier(2)->Range(8, 64);
+
+static void BM_IncludedInChain(benchmark::State& state){
+  fa::Automaton lhs = createChain(state.range(0));
+  fa::Automaton rhs = createRandomDfa(state.range(0), 2, 7);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(lhs.isIncludedIn(rhs));
+  }
+  setCounters(state, rhs);
+}
+BENCHMARK(BM_IncludedInChain)->RangeMultiplier(10)->Range(100, 1000000);
+
+static void BM_IncludedInBlowUp(benchmark::State& state){
+  fa::Automaton lhs = createBlowUp(state.range(0) - 1);
+  fa::Automaton rhs = createBlowUp(state.range(0));
+  for(auto _ : state){
+    benchmark::DoNotOptimize(lhs.isIncludedIn(rhs));
+  }
+  setCounters(state, rhs);
+}
+BENCHMARK(BM_IncludedInBlowUp)->DenseRange(6, 19, 1);
+
+static void BM_ShortestDifferenceWordBlowUp(benchmark::State& state){
+  fa::Automaton lhs = createBlowUp(state.range(0) - 1);
+  fa::Automaton rhs = createBlowUp(state.range(0));
+  for(auto _ : state){
+    benchmark::DoNotOptimize(lhs.shortestDifferenceWord(rhs));
+  }
+  setCounters(state, rhs);
+}
+BENCHMARK(BM_ShortestDifferenceWordBlowUp)->DenseRange(6, 19, 1);
+
+/* the regression check of a minimization: the NFA against its minimal DFA */
+static void BM_EquivalentBlowUp(benchmark::State& state){
+  fa::Automaton lhs = createBlowUp(state.range(0));
+  fa::Automaton rhs = fa::Automaton::createMinimalMoore(lhs);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(lhs.isEquivalentTo(rhs));
+  }
+  setCounters(state, rhs);
+}
+BENCHMARK(BM_EquivalentBlowUp)->DenseRange(6, 12, 2);
+
+static void BM_EquivalentBlowUpByInclusion(benchmark::State& state){
+  fa::Automaton lhs = createBlowUp(state.range(0));
+  fa::Automaton rhs = fa::Automaton::createMinimalMoore(lhs);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(lhs.isIncludedIn(rhs) && rhs.isIncludedIn(lhs));
+  }
+  setCounters(state, rhs);
+}
+BENCHMARK(BM_EquivalentBlowUpByInclusion)->DenseRange(6, 12, 2);
+
+/* an allow-all policy: the blow-up next to a final state looping on every letter */
+static fa::Automaton createAllowAll(int n){
+  fa::Automaton fa = createBlowUp(n);
+  fa.addState(n + 2);
+  fa.setStateInitial(n + 2);
+  fa.setStateFinal(n + 2);
+  fa.addTransition(n + 2, 'a', n + 2);
+  fa.addTransition(n + 2, 'b', n + 2);
+  return fa;
+}
+
+static void BM_UniversalAllowAll(benchmark::State& state){
+  fa::Automaton fa = createAllowAll(state.range(0));
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa.isUniversal());
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_UniversalAllowAll)->DenseRange(6, 19, 1);
+
+static void BM_UniversalAllowAllByComplement(benchmark::State& state){
+  fa::Automaton fa = createAllowAll(state.range(0));
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa::Automaton::createComplement(fa).isLanguageEmpty());
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_UniversalAllowAllByComplement)->DenseRange(6, 19, 1);
+
+static void BM_WithoutEpsilonThompson(benchmark::State& state){
+  fa::Automaton fa = createThompson(state.range(0));
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa::Automaton::createWithoutEpsilon(fa));
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_WithoutEpsilonThompson)->RangeMultiplier(10)->Range(100, 1000000);
+
+static void BM_ReducedBySimulationThompson(benchmark::State& state){
+  fa::Automaton fa = fa::Automaton::createWithoutEpsilon(createThompson(state.range(0)));
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa::Automaton::createReducedBySimulation(fa));
+  }
+  setCounters(state, fa);
+  state.counters["reduced"] = fa::Automaton::createReducedBySimulation(fa).countStates();
+}
+BENCHMARK(BM_ReducedBySimulationThompson)->RangeMultiplier(10)->Range(100, 10000);
+
+static void BM_MatchReducedThompson(benchmark::State& state){
+  fa::Automaton fa = fa::Automaton::createReducedBySimulation(createThompson(state.range(0)));
+  std::string word = createWord(1000, 2) + "c";
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa.match(word));
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_MatchReducedThompson)->RangeMultiplier(10)->Range(100, 10000);
+
+static void BM_ReducedByBisimulationThompson(benchmark::State& state){
+  fa::Automaton fa = fa::Automaton::createWithoutEpsilon(createThompson(state.range(0)));
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa::Automaton::createReducedByBisimulation(fa));
+  }
+  setCounters(state, fa);
+  state.counters["reduced"] = fa::Automaton::createReducedByBisimulation(fa).countStates();
+}
+BENCHMARK(BM_ReducedByBisimulationThompson)->RangeMultiplier(10)->Range(100, 1000000);
+
+static void BM_ReducedByBisimulationRandomNfa(benchmark::State& state){
+  fa::Automaton fa = createRandomNfa(state.range(0), 2, 2, 3);
+  for(auto _ : state){
+    benchmark::DoNotOptimize(fa::Automaton::createReducedByBisimulation(fa));
+  }
+  setCounters(state, fa);
+}
+BENCHMARK(BM_ReducedByBisimulationRandomNfa)->RangeMultiplier(10)->Range(100, 1000000);
+
+BENCHMARK_MAIN();
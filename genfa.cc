@@ -0,0 +1,31 @@
+#include "Automaton.h"
+#include "BlowUp.h"
+
+#include <fstream>
+#include <iostream>
+
+
+/*
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Write the C++ sources of the automata matched ahead of time by benchfa    *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+int main(int argc, char* argv[]){
+  if(argc != 2){
+    std::cerr << "usage: " << argv[0] << " <output.cc>" << std::endl;
+    return 1;
+  }
+
+  std::ofstream os(argv[1]);
+  if(!os){
+    std::cerr << "cannot write " << argv[1] << std::endl;
+    return 1;
+  }
+
+  fa::Automaton minimal = fa::Automaton::createMinimalMoore(createBlowUp(4));
+  minimal.generateSource(os, "matchBlowUpGoto", fa::SourceStyle::Goto);
+  os << "\n";
+  minimal.generateSource(os, "matchBlowUpSwitch", fa::SourceStyle::Switch);
+  return os ? 0 : 1;
+}
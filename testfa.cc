@@ -1,5 +1,11 @@
 #include "gtest/gtest.h"
 #include "Automaton.h"
+#include "Enumerator.h"
+#include "Sampler.h"
+#include "StaticAutomaton.h"
+#include "SymbolicAutomaton.h"
+
+#include <sstream>
 
 
 /*
@@ -198,6 +204,75 @@ TEST(STATE, NoFinalState){
   EXPECT_FALSE(fa.isStateFinal(0));  
 }
 
+TEST(STATE, CompactAfterRemove){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addState(10));
+  EXPECT_TRUE(fa.addState(20));
+  EXPECT_TRUE(fa.addState(30));
+  fa.setStateInitial(10);
+  fa.setStateFinal(30);
+  EXPECT_TRUE(fa.addTransition(10, 'a', 20));
+  EXPECT_TRUE(fa.addTransition(20, 'a', 30));
+  EXPECT_TRUE(fa.addTransition(10, 'a', 30));
+
+  EXPECT_TRUE(fa.removeState(20));
+  EXPECT_FALSE(fa.removeState(20));
+  EXPECT_EQ(fa.countStates(), 2u);
+  EXPECT_EQ(fa.countTransitions(), 1u);
+
+  fa.compact();
+  EXPECT_EQ(fa.countStates(), 2u);
+  EXPECT_FALSE(fa.hasState(20));
+  EXPECT_TRUE(fa.isStateInitial(10));
+  EXPECT_TRUE(fa.isStateFinal(30));
+  EXPECT_TRUE(fa.hasTransition(10, 'a', 30));
+  EXPECT_TRUE(fa.match("a"));
+  EXPECT_FALSE(fa.match("aa"));
+}
+
+TEST(STATE, AddAfterCompact){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  for(int i = 0; i < 100; i++){
+    EXPECT_TRUE(fa.addState(i));
+  }
+  for(int i = 0; i < 100; i += 2){
+    EXPECT_TRUE(fa.removeState(i));
+  }
+  fa.compact();
+  EXPECT_EQ(fa.countStates(), 50u);
+  EXPECT_TRUE(fa.addState(0));
+  EXPECT_FALSE(fa.addState(1));
+  EXPECT_TRUE(fa.addTransition(0, 'a', 99));
+  EXPECT_TRUE(fa.hasTransition(0, 'a', 99));
+  EXPECT_FALSE(fa.hasTransition(0, 'a', 98));
+  EXPECT_EQ(fa.countStates(), 51u);
+}
+
+TEST(STATE, SuccessorsAfterRemove){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  EXPECT_TRUE(fa.addState(10));
+  EXPECT_TRUE(fa.addState(20));
+  EXPECT_TRUE(fa.addState(30));
+  fa.setStateInitial(10);
+  fa.setStateFinal(30);
+  EXPECT_TRUE(fa.addTransition(10, 'b', 30));
+  EXPECT_TRUE(fa.addTransition(10, 'a', 20));
+  EXPECT_TRUE(fa.addTransition(10, 'a', 30));
+  EXPECT_TRUE(fa.removeState(20));
+
+  /* the removed state is skipped without compacting the automaton */
+  fa::Successors successors = fa.getSuccessors();
+  EXPECT_EQ(successors.begin, (std::vector<std::size_t>{0, 2, 2}));
+  EXPECT_EQ(successors.letters, (std::vector<char>{'a', 'b'}));
+  EXPECT_EQ(successors.targets, (std::vector<int>{1, 1}));
+  EXPECT_EQ(successors.initials, (std::vector<bool>{true, false}));
+  EXPECT_EQ(successors.finals, (std::vector<bool>{false, true}));
+}
+
 
 /*
 * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -713,6 +788,34 @@ TEST(PROPERTY, MakeCompleteNoNewState){
   EXPECT_FALSE(new_fa.match("aaababababaa"));
 }
 
+TEST(PROPERTY, MakeCompleteLarge){
+  /* a chain of 20000 states over 90 letters, each state missing all the letters but one */
+  const int n = 20000;
+  fa::Automaton fa;
+  for(char letter = '!'; letter < '!' + 90; letter++){
+    EXPECT_TRUE(fa.addSymbol(letter));
+  }
+  for(int i = 0; i < n; i++){
+    fa.addState(i);
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(n - 1);
+  for(int i = 0; i + 1 < n; i++){
+    fa.addTransition(i, '!' + i % 90, i + 1);
+  }
+
+  fa.complete();
+  EXPECT_TRUE(fa.isComplete());
+  EXPECT_TRUE(fa.isDeterministic());
+  EXPECT_EQ(fa.countStates(), std::size_t(n + 1));
+  EXPECT_EQ(fa.countTransitions(), std::size_t(n + 1) * 90);
+
+  /* the missing letters lead to the new sink, which loops on every letter */
+  EXPECT_TRUE(fa.hasTransition(n - 1, 'a', n));
+  EXPECT_TRUE(fa.hasTransition(n, 'a', n));
+  EXPECT_FALSE(fa.match("!\"$"));
+}
+
 TEST(PROPERTY, MakeMirrorSimple){
   fa::Automaton fa;
   EXPECT_TRUE(fa.addSymbol('a'));
@@ -2694,6 +2797,113 @@ TEST(DETERMINIST, MakeDeterministicAlreadyDeterminist){
   EXPECT_TRUE(deterministic.match("bbbbb"));
 }
 
+/**
+ * The NFA of (a|b)*a(a|b)^(n-1), with n + 1 states, which needs 2^n states once deterministic
+ */
+static fa::Automaton createSuffixExample(int n){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  for(int i = 0; i <= n; i++){
+    EXPECT_TRUE(fa.addState(i));
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(n);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 0));
+  EXPECT_TRUE(fa.addTransition(0, 'b', 0));
+  EXPECT_TRUE(fa.addTransition(0, 'a', 1));
+  for(int i = 1; i < n; i++){
+    EXPECT_TRUE(fa.addTransition(i, 'a', i + 1));
+    EXPECT_TRUE(fa.addTransition(i, 'b', i + 1));
+  }
+  return fa;
+}
+
+TEST(DETERMINIST, MakeDeterministicParallel){
+  fa::Automaton fa = createSuffixExample(7);
+
+  fa::Automaton sequential = fa::Automaton::createDeterministic(fa);
+  fa::Automaton parallel = fa::Automaton::createDeterministic(fa, 4);
+
+  EXPECT_TRUE(parallel.isDeterministic());
+  EXPECT_EQ(sequential.countStates(), 128u);
+  EXPECT_EQ(parallel.countStates(), sequential.countStates());
+  EXPECT_EQ(parallel.countTransitions(), sequential.countTransitions());
+  EXPECT_TRUE(parallel.match("abbbbbb"));
+  EXPECT_TRUE(parallel.match("bbaabaabb"));
+  EXPECT_FALSE(parallel.match("abbbbb"));
+  EXPECT_FALSE(parallel.match("bbbbbbbbbb"));
+
+  /* the numbering does not depend on the number of threads */
+  for(int from = 0; from < 128; from++){
+    EXPECT_EQ(parallel.isStateFinal(from), sequential.isStateFinal(from));
+    for(int to = 0; to < 128; to++){
+      EXPECT_EQ(parallel.hasTransition(from, 'a', to), sequential.hasTransition(from, 'a', to));
+      EXPECT_EQ(parallel.hasTransition(from, 'b', to), sequential.hasTransition(from, 'b', to));
+    }
+  }
+}
+
+TEST(DETERMINIST, MakeDeterministicAllCores){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  EXPECT_TRUE(fa.addState(0));
+  EXPECT_TRUE(fa.addState(1));
+  EXPECT_TRUE(fa.addState(2));
+  fa.setStateInitial(0);
+  fa.setStateInitial(1);
+  fa.setStateFinal(2);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 2));
+  EXPECT_TRUE(fa.addTransition(1, 'a', 1));
+  EXPECT_TRUE(fa.addTransition(1, 'b', 2));
+
+  fa::Automaton deterministic = fa::Automaton::createDeterministic(fa, 0);
+
+  EXPECT_TRUE(deterministic.isDeterministic());
+  EXPECT_EQ(deterministic.countStates(), 4u);
+  EXPECT_TRUE(deterministic.match("a"));
+  EXPECT_TRUE(deterministic.match("ab"));
+  EXPECT_TRUE(deterministic.match("aab"));
+  EXPECT_FALSE(deterministic.match("aa"));
+  EXPECT_FALSE(deterministic.match("ba"));
+}
+
+
+TEST(DETERMINIST, MakeDeterministicEpsilon){
+  /* a*(b|c) with the choice behind epsilon transitions, as built by Thompson */
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  EXPECT_TRUE(fa.addSymbol('c'));
+  for(int i = 0; i < 5; i++){
+    EXPECT_TRUE(fa.addState(i));
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(4);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 0));
+  EXPECT_TRUE(fa.addTransition(0, fa::Epsilon, 1));
+  EXPECT_TRUE(fa.addTransition(1, fa::Epsilon, 2));
+  EXPECT_TRUE(fa.addTransition(1, fa::Epsilon, 3));
+  EXPECT_TRUE(fa.addTransition(2, 'b', 4));
+  EXPECT_TRUE(fa.addTransition(3, 'c', 4));
+
+  fa::Automaton deterministic = fa::Automaton::createDeterministic(fa);
+  EXPECT_TRUE(deterministic.isDeterministic());
+  EXPECT_FALSE(deterministic.hasEpsilonTransition());
+  EXPECT_EQ(deterministic.countStates(), 2u);
+  EXPECT_TRUE(deterministic.match("b"));
+  EXPECT_TRUE(deterministic.match("aac"));
+  EXPECT_FALSE(deterministic.match(""));
+  EXPECT_FALSE(deterministic.match("bc"));
+  EXPECT_TRUE(deterministic.isEquivalentTo(fa));
+
+  /* the mirror follows the epsilon transitions backward */
+  fa::Automaton minimal = fa::Automaton::createMinimalBrzozowski(fa);
+  EXPECT_EQ(minimal.countStates(), 3u);
+  EXPECT_TRUE(minimal.isEquivalentTo(fa));
+  EXPECT_EQ(fa::Automaton::createMinimalMoore(fa).countStates(), 3u);
+}
 
 /*
 * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -3492,6 +3702,46 @@ TEST(MOORE, NoFinalState) {
   EXPECT_FALSE(minimalMoore.match(""));
 }
 
+TEST(MOORE, Parallel) {
+  /* count the letters 'a' modulo 3 with a cycle of 9000 states */
+  fa::Automaton fa;
+  const int n = 9000;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  for(int i = 0; i < n; i++){
+    EXPECT_TRUE(fa.addState(i));
+    if(i % 3 == 0){
+      fa.setStateFinal(i);
+    }
+  }
+  fa.setStateInitial(0);
+  for(int i = 0; i < n; i++){
+    EXPECT_TRUE(fa.addTransition(i, 'a', (i + 1) % n));
+    EXPECT_TRUE(fa.addTransition(i, 'b', i));
+  }
+
+  fa::Automaton sequential = fa::Automaton::createMinimalMoore(fa);
+  fa::Automaton parallel = fa::Automaton::createMinimalMoore(fa, 4);
+
+  EXPECT_EQ(sequential.countStates(), 3u);
+  EXPECT_EQ(parallel.countStates(), 3u);
+  EXPECT_TRUE(parallel.isDeterministic());
+  EXPECT_TRUE(parallel.isComplete());
+  EXPECT_TRUE(parallel.match(""));
+  EXPECT_TRUE(parallel.match("abbaba"));
+  EXPECT_FALSE(parallel.match("abbab"));
+
+  /* the numbering does not depend on the number of threads */
+  for(int from = 1; from <= 3; from++){
+    EXPECT_EQ(parallel.isStateInitial(from), sequential.isStateInitial(from));
+    EXPECT_EQ(parallel.isStateFinal(from), sequential.isStateFinal(from));
+    for(int to = 1; to <= 3; to++){
+      EXPECT_EQ(parallel.hasTransition(from, 'a', to), sequential.hasTransition(from, 'a', to));
+      EXPECT_EQ(parallel.hasTransition(from, 'b', to), sequential.hasTransition(from, 'b', to));
+    }
+  }
+}
+
 
 /*
 * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -3793,6 +4043,1785 @@ TEST(BRZOZOWSKI, NoFinalState) {
   EXPECT_FALSE(minimalBrzozowski.match(""));
 }
 
+TEST(BRZOZOWSKI, SameAsMoore) {
+  fa::Automaton fa;
+
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+
+  /* (a|b)*a(a|b)^3, whose minimal automaton has 16 states */
+  for(int i = 0; i < 5; i++){
+    EXPECT_TRUE(fa.addState(i));
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(4);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 0));
+  EXPECT_TRUE(fa.addTransition(0, 'b', 0));
+  EXPECT_TRUE(fa.addTransition(0, 'a', 1));
+  for(int i = 1; i < 4; i++){
+    EXPECT_TRUE(fa.addTransition(i, 'a', i + 1));
+    EXPECT_TRUE(fa.addTransition(i, 'b', i + 1));
+  }
+
+  fa::Automaton minimalBrzozowski = fa::Automaton::createMinimalBrzozowski(fa);
+  fa::Automaton minimalMoore = fa::Automaton::createMinimalMoore(fa);
+
+  EXPECT_EQ(minimalBrzozowski.countStates(), 16u);
+  EXPECT_EQ(minimalBrzozowski.countStates(), minimalMoore.countStates());
+  EXPECT_EQ(minimalBrzozowski.countTransitions(), minimalMoore.countTransitions());
+  EXPECT_TRUE(minimalBrzozowski.isDeterministic());
+  EXPECT_TRUE(minimalBrzozowski.isComplete());
+  for(std::string word : {"", "a", "abbb", "aaaa", "babab", "bbbbb", "abbbb"}){
+    EXPECT_EQ(minimalBrzozowski.match(word), fa.match(word)) << word;
+  }
+
+  /* the input is left untouched */
+  EXPECT_EQ(fa.countStates(), 5u);
+  EXPECT_TRUE(fa.isStateInitial(0));
+  EXPECT_TRUE(fa.hasTransition(0, 'a', 1));
+}
+
+
+/*
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Those tests exist in order to test the automate labelled by ranges of symbols        *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+TEST(SYMBOLIC, CharSetOperations){
+  fa::CharSet lower('a', 'z');
+  fa::CharSet digits('0', '9');
+
+  fa::CharSet word = fa::CharSet::createUnion(lower, digits);
+  EXPECT_EQ(word.getRanges().size(), 2u);
+  EXPECT_EQ(word.countSymbols(), 36u);
+  EXPECT_TRUE(word.contains('5'));
+  EXPECT_TRUE(word.contains('q'));
+  EXPECT_FALSE(word.contains('A'));
+
+  word.add('A', 'Z');
+  word.add('[', '`');
+  EXPECT_EQ(word.getRanges().size(), 2u);
+  EXPECT_TRUE(word.contains('_'));
+
+  EXPECT_TRUE(fa::CharSet::createIntersection(lower, digits).isEmpty());
+  EXPECT_EQ(fa::CharSet::createIntersection(word, lower), lower);
+  EXPECT_EQ(fa::CharSet::createDifference(word, lower).countSymbols(), 10u + 32u);
+  EXPECT_EQ(fa::CharSet::createComplement(fa::CharSet(), fa::MaxByte).countSymbols(), 256u);
+  EXPECT_EQ(fa::CharSet::createComplement(lower, fa::MaxByte).countSymbols(), 256u - 26u);
+}
+
+TEST(SYMBOLIC, CharacterClassIsOneTransition){
+  fa::SymbolicAutomaton fa;
+  EXPECT_TRUE(fa.addState(0));
+  EXPECT_TRUE(fa.addState(1));
+  fa.setStateInitial(0);
+  fa.setStateFinal(1);
+
+  EXPECT_TRUE(fa.addTransition(0, fa::CharSet('a', 'z'), 1));
+  EXPECT_TRUE(fa.addTransition(0, fa::CharSet('A', 'Z'), 1));
+  EXPECT_TRUE(fa.addTransition(1, fa::CharSet('0', '9'), 1));
+  EXPECT_FALSE(fa.addTransition(0, fa::CharSet(), 1));
+  EXPECT_FALSE(fa.addTransition(0, fa::CharSet(0x100), 1));
+  EXPECT_FALSE(fa.addTransition(0, fa::CharSet('a'), 2));
+
+  EXPECT_EQ(fa.countTransitions(), 2u);
+  EXPECT_TRUE(fa.hasTransition(0, 'Q', 1));
+  EXPECT_FALSE(fa.hasTransition(0, '5', 1));
+  EXPECT_TRUE(fa.isDeterministic());
+  EXPECT_FALSE(fa.isComplete());
+
+  EXPECT_TRUE(fa.match("x"));
+  EXPECT_TRUE(fa.match("X2021"));
+  EXPECT_FALSE(fa.match(""));
+  EXPECT_FALSE(fa.match("2021"));
+  EXPECT_FALSE(fa.match("ab"));
+}
+
+TEST(SYMBOLIC, FullByteAlphabet){
+  fa::SymbolicAutomaton fa(fa::Encoding::Byte);
+  EXPECT_TRUE(fa.addState(0));
+  fa.setStateInitial(0);
+  fa.setStateFinal(0);
+  EXPECT_TRUE(fa.addTransition(0, fa::CharSet(0x00, 0x1F), 0));
+  EXPECT_TRUE(fa.addTransition(0, fa::CharSet(0x80, 0xFF), 0));
+
+  EXPECT_TRUE(fa.match(std::string("\0\x01\x1f", 3)));
+  EXPECT_TRUE(fa.match("\x80\xff\xc3\xa9"));
+  EXPECT_FALSE(fa.match("\x01 \x02"));
+  EXPECT_TRUE(fa.isValid());
+}
+
+TEST(SYMBOLIC, Utf8CodePoints){
+  fa::SymbolicAutomaton fa(fa::Encoding::Utf8);
+  EXPECT_TRUE(fa.addState(0));
+  EXPECT_TRUE(fa.addState(1));
+  fa.setStateInitial(0);
+  fa.setStateFinal(1);
+  /* greek letters then any emoji of the first block */
+  EXPECT_TRUE(fa.addTransition(0, fa::CharSet(0x391, 0x3C9), 0));
+  EXPECT_TRUE(fa.addTransition(0, fa::CharSet(0x1F600, 0x1F64F), 1));
+
+  EXPECT_TRUE(fa.match("\xce\xb1\xce\xb2\xf0\x9f\x98\x80"));   // αβ😀
+  EXPECT_TRUE(fa.match("\xf0\x9f\x99\x8f"));                   // 🙏
+  EXPECT_FALSE(fa.match("a\xf0\x9f\x98\x80"));
+  EXPECT_FALSE(fa.match("\xce"));                              // truncated
+  EXPECT_FALSE(fa.match("\xc0\x80"));                          // overlong
+  EXPECT_FALSE(fa.match("\xed\xa0\x80"));                      // surrogate
+
+  std::u32string symbols;
+  EXPECT_TRUE(fa::SymbolicAutomaton::decode("\xe2\x82\xac", fa::Encoding::Utf8, symbols));
+  EXPECT_EQ(symbols, std::u32string(1, 0x20AC));
+  EXPECT_TRUE(fa.match(std::u32string{0x3A9, 0x1F642}));
+}
+
+TEST(SYMBOLIC, DeterministicOverMinterms){
+  fa::SymbolicAutomaton fa;
+  EXPECT_TRUE(fa.addState(0));
+  EXPECT_TRUE(fa.addState(1));
+  EXPECT_TRUE(fa.addState(2));
+  fa.setStateInitial(0);
+  fa.setStateFinal(2);
+  /* [a-z]* [m-p] [0-9] with overlapping labels */
+  EXPECT_TRUE(fa.addTransition(0, fa::CharSet('a', 'z'), 0));
+  EXPECT_TRUE(fa.addTransition(0, fa::CharSet('m', 'p'), 1));
+  EXPECT_TRUE(fa.addTransition(1, fa::CharSet('0', '9'), 2));
+  EXPECT_FALSE(fa.isDeterministic());
+
+  fa::SymbolicAutomaton dfa = fa::SymbolicAutomaton::createDeterministic(fa);
+  EXPECT_TRUE(dfa.isDeterministic());
+  EXPECT_EQ(dfa.countStates(), 3u);
+  EXPECT_TRUE(dfa.match("abcn5"));
+  EXPECT_TRUE(dfa.match("p0"));
+  EXPECT_FALSE(dfa.match("abc5"));
+  EXPECT_FALSE(dfa.match("n55"));
+  /* a byte alphabet would need 256 letters, the minterms keep few edges */
+  EXPECT_LE(dfa.countTransitions(), 8u);
+}
+
+TEST(SYMBOLIC, Complete){
+  fa::SymbolicAutomaton fa;
+  EXPECT_TRUE(fa.addState(0));
+  EXPECT_TRUE(fa.addState(1));
+  fa.setStateInitial(0);
+  fa.setStateFinal(1);
+  EXPECT_TRUE(fa.addTransition(0, fa::CharSet('a', 'f'), 1));
+
+  fa::SymbolicAutomaton complete = fa::SymbolicAutomaton::createComplete(fa);
+  EXPECT_TRUE(complete.isComplete());
+  EXPECT_EQ(complete.countStates(), 3u);
+  EXPECT_EQ(complete.countTransitions(), 4u);
+  EXPECT_TRUE(complete.match("c"));
+  EXPECT_FALSE(complete.match("g"));
+  EXPECT_FALSE(complete.match("cc"));
+}
+
+TEST(SYMBOLIC, CompleteGreatestState){
+  fa::SymbolicAutomaton fa;
+  EXPECT_TRUE(fa.addState(INT_MAX));
+  fa.setStateInitial(INT_MAX);
+  fa.setStateFinal(INT_MAX);
+  EXPECT_TRUE(fa.addTransition(INT_MAX, fa::CharSet('a', 'f'), INT_MAX));
+
+  fa::SymbolicAutomaton complete = fa::SymbolicAutomaton::createComplete(fa);
+  EXPECT_TRUE(complete.isComplete());
+  EXPECT_EQ(complete.countStates(), 2u);
+  EXPECT_TRUE(complete.hasState(INT_MAX));
+  EXPECT_TRUE(complete.hasState(INT_MAX - 1));
+  EXPECT_TRUE(complete.match("abc"));
+  EXPECT_FALSE(complete.match("ag"));
+}
+
+TEST(SYMBOLIC, Product){
+  fa::SymbolicAutomaton lhs;
+  EXPECT_TRUE(lhs.addState(0));
+  lhs.setStateInitial(0);
+  lhs.setStateFinal(0);
+  EXPECT_TRUE(lhs.addTransition(0, fa::CharSet('a', 'm'), 0));
+
+  fa::SymbolicAutomaton rhs;
+  EXPECT_TRUE(rhs.addState(0));
+  EXPECT_TRUE(rhs.addState(1));
+  rhs.setStateInitial(0);
+  rhs.setStateFinal(1);
+  EXPECT_TRUE(rhs.addTransition(0, fa::CharSet('h', 'z'), 1));
+  EXPECT_TRUE(rhs.addTransition(1, fa::CharSet('h', 'z'), 0));
+
+  fa::SymbolicAutomaton product = fa::SymbolicAutomaton::createProduct(lhs, rhs);
+  EXPECT_EQ(product.countStates(), 2u);
+  EXPECT_EQ(product.countTransitions(), 2u);
+  EXPECT_TRUE(product.match("h"));
+  EXPECT_TRUE(product.match("ijk"));
+  EXPECT_FALSE(product.match("hi"));
+  EXPECT_FALSE(product.match("n"));
+  EXPECT_FALSE(product.match("a"));
+}
+
+TEST(SYMBOLIC, MinimalMoore){
+  fa::SymbolicAutomaton fa;
+  for(int i = 0; i < 5; i++){
+    EXPECT_TRUE(fa.addState(i));
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(3);
+  fa.setStateFinal(4);
+  /* two equivalent branches for [0-9]+ ; hex letters on both sides */
+  EXPECT_TRUE(fa.addTransition(0, fa::CharSet('0', '4'), 1));
+  EXPECT_TRUE(fa.addTransition(0, fa::CharSet('5', '9'), 2));
+  EXPECT_TRUE(fa.addTransition(1, fa::CharSet('a', 'f'), 3));
+  EXPECT_TRUE(fa.addTransition(2, fa::CharSet('a', 'c'), 4));
+  EXPECT_TRUE(fa.addTransition(2, fa::CharSet('d', 'f'), 3));
+  EXPECT_TRUE(fa.addTransition(3, fa::CharSet('a', 'f'), 4));
+  EXPECT_TRUE(fa.addTransition(4, fa::CharSet('a', 'f'), 3));
+
+  fa::SymbolicAutomaton minimal = fa::SymbolicAutomaton::createMinimalMoore(fa);
+  /* initial, after a digit, accepting, sink */
+  EXPECT_EQ(minimal.countStates(), 4u);
+  EXPECT_TRUE(minimal.isDeterministic());
+  EXPECT_TRUE(minimal.isComplete());
+  EXPECT_TRUE(minimal.match("0a"));
+  EXPECT_TRUE(minimal.match("9ffff"));
+  EXPECT_FALSE(minimal.match("9"));
+  EXPECT_FALSE(minimal.match("a0"));
+  EXPECT_FALSE(minimal.match("5g"));
+}
+
+/*
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Those tests exist in order to test the sets of states of the automata *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+TEST(STATESET, InsertAndFind){
+  fa::StateSet set;
+  EXPECT_TRUE(set.empty());
+  EXPECT_TRUE(set.insert(42));
+  EXPECT_TRUE(set.insert(-3));
+  EXPECT_TRUE(set.insert(INT_MAX));
+  EXPECT_FALSE(set.insert(42));
+  EXPECT_EQ(set.size(), 3u);
+  EXPECT_TRUE(set.find(-3) != set.end());
+  EXPECT_TRUE(set.find(INT_MAX) != set.end());
+  EXPECT_TRUE(set.find(0) == set.end());
+  EXPECT_FALSE(set.isDense());
+
+  std::vector<int> states(set.begin(), set.end());
+  EXPECT_EQ(states, std::vector<int>({-3, 42, INT_MAX}));
+
+  EXPECT_TRUE(set.erase(42));
+  EXPECT_FALSE(set.erase(42));
+  EXPECT_EQ(set.size(), 2u);
+  EXPECT_FALSE(set.contains(42));
+}
+
+TEST(STATESET, DenseAsBitset){
+  fa::StateSet set;
+  for(int state = 99; state >= 0; state -= 2){
+    EXPECT_TRUE(set.insert(state));
+  }
+  EXPECT_TRUE(set.isDense());
+  EXPECT_EQ(set.size(), 50u);
+  EXPECT_TRUE(set.contains(51));
+  EXPECT_FALSE(set.contains(50));
+  EXPECT_EQ(*set.begin(), 1);
+  EXPECT_EQ(*set.find(97), 97);
+
+  /* a state far away makes the set sparse again */
+  EXPECT_TRUE(set.insert(1000000));
+  EXPECT_FALSE(set.isDense());
+  EXPECT_EQ(set.size(), 51u);
+  EXPECT_TRUE(set.contains(51));
+  EXPECT_TRUE(set.contains(1000000));
+
+  /* the storage does not change the comparison nor the hash */
+  fa::StateSet sorted;
+  for(int state : set){
+    EXPECT_TRUE(sorted.insert(state));
+  }
+  EXPECT_TRUE(set == sorted);
+  EXPECT_EQ(set.hash(), sorted.hash());
+  EXPECT_TRUE(sorted.erase(1000000));
+  EXPECT_TRUE(set.erase(1000000));
+  EXPECT_TRUE(set == sorted);
+  EXPECT_EQ(std::hash<fa::StateSet>()(set), std::hash<fa::StateSet>()(sorted));
+}
+
+TEST(STATESET, UnionIntersection){
+  fa::StateSet even, odd, small = {1, 2, 3};
+  for(int state = 0; state < 64; state++){
+    if(state % 2 == 0){
+      EXPECT_TRUE(even.insert(state));
+    }else{
+      EXPECT_TRUE(odd.insert(state));
+    }
+  }
+  EXPECT_TRUE(even.isDense());
+
+  fa::StateSet all = fa::StateSet::createUnion(even, odd);
+  EXPECT_EQ(all.size(), 64u);
+  EXPECT_TRUE(fa::StateSet::createIntersection(even, odd).empty());
+  EXPECT_TRUE(fa::StateSet::createIntersection(all, even) == even);
+  EXPECT_TRUE(fa::StateSet::createIntersection(small, even) == fa::StateSet({2}));
+  EXPECT_TRUE(fa::StateSet::createIntersection(odd, small) == fa::StateSet({1, 3}));
+  EXPECT_TRUE(fa::StateSet::createUnion(small, fa::StateSet({-1, 3, 7})) == fa::StateSet({-1, 1, 2, 3, 7}));
+  EXPECT_EQ(fa::StateSet::createUnion(even, small).size(), 34u);
+}
+
+TEST(STATESET, Inclusion){
+  fa::StateSet even, all, small = {2, 4}, negative = {-1, 2};
+  for(int state = 0; state < 64; state++){
+    if(state % 2 == 0){
+      EXPECT_TRUE(even.insert(state));
+    }
+    EXPECT_TRUE(all.insert(state));
+  }
+  EXPECT_TRUE(even.isDense());
+
+  EXPECT_TRUE(even.isIncludedIn(all));
+  EXPECT_FALSE(all.isIncludedIn(even));
+  EXPECT_TRUE(small.isIncludedIn(even));
+  EXPECT_FALSE(negative.isIncludedIn(all));
+  EXPECT_TRUE(fa::StateSet().isIncludedIn(small));
+  EXPECT_TRUE(small.isIncludedIn(fa::StateSet({1, 2, 3, 4})));
+  EXPECT_FALSE(small.isIncludedIn(fa::StateSet({1, 2, 3})));
+}
+
+TEST(STATESET, CopyAndMove){
+  fa::StateSet set;
+  for(int state = 0; state < 10; state++){
+    EXPECT_TRUE(set.insert(state * 7));
+  }
+  std::pmr::monotonic_buffer_resource arena;
+  fa::StateSet copy(set, &arena);
+  EXPECT_EQ(copy.getResource(), &arena);
+  EXPECT_TRUE(copy == set);
+
+  fa::StateSet moved = std::move(copy);
+  EXPECT_TRUE(moved == set);
+  EXPECT_TRUE(copy.empty());
+
+  copy = moved;
+  EXPECT_TRUE(copy == set);
+  copy.clear();
+  EXPECT_TRUE(copy.empty());
+  EXPECT_TRUE(copy != set);
+}
+
+/*
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Those tests exist in order to test the counters recorded by the algorithms *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+TEST(STATS, Deterministic){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  EXPECT_TRUE(fa.addState(0));
+  EXPECT_TRUE(fa.addState(1));
+  EXPECT_TRUE(fa.addState(2));
+  fa.setStateInitial(0);
+  fa.setStateFinal(2);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 0));
+  EXPECT_TRUE(fa.addTransition(0, 'b', 0));
+  EXPECT_TRUE(fa.addTransition(0, 'a', 1));
+  EXPECT_TRUE(fa.addTransition(1, 'b', 2));
+
+  fa::Stats stats;
+  std::size_t calls = 0;
+  stats.progress = [&](const fa::Stats&){
+    calls++;
+  };
+  fa::Automaton deterministic = fa::Automaton::createDeterministic(fa, 1, stats);
+  fa::Automaton reference = fa::Automaton::createDeterministic(fa);
+
+  EXPECT_EQ(deterministic.countStates(), reference.countStates());
+  EXPECT_EQ(deterministic.countTransitions(), reference.countTransitions());
+#ifdef FA_ENABLE_STATS
+  EXPECT_EQ(stats.subsetsExplored, deterministic.countStates());
+  EXPECT_EQ(stats.peakStates, deterministic.countStates());
+  EXPECT_EQ(stats.peakTransitions, deterministic.countTransitions());
+  ASSERT_EQ(stats.phases.size(), 2u);
+  EXPECT_EQ(stats.phases[0].name, "subsets");
+  EXPECT_GT(stats.phases[0].allocations, 0u);
+  EXPECT_EQ(stats.phases[1].name, "renumbering");
+  EXPECT_GT(calls, 0u);
+#else
+  EXPECT_EQ(stats.subsetsExplored, 0u);
+  EXPECT_TRUE(stats.phases.empty());
+  EXPECT_EQ(calls, 0u);
+#endif
+}
+
+TEST(STATS, MinimalMoore){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  for(int i = 0; i < 6; i++){
+    EXPECT_TRUE(fa.addState(i));
+  }
+  for(int i = 0; i < 6; i++){
+    EXPECT_TRUE(fa.addTransition(i, 'a', (i + 1) % 6));
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(0);
+  fa.setStateFinal(3);
+
+  fa::Stats stats;
+  fa::Automaton minimal = fa::Automaton::createMinimalMoore(fa, 1, stats);
+  EXPECT_EQ(minimal.countStates(), 3u);
+#ifdef FA_ENABLE_STATS
+  /* the classes split at the first round, the second one finds them stable */
+  EXPECT_EQ(stats.refinementRounds, 2u);
+  EXPECT_EQ(stats.peakStates, 6u);
+  ASSERT_EQ(stats.phases.size(), 2u);
+  EXPECT_EQ(stats.phases[0].name, "refinement");
+  EXPECT_EQ(stats.phases[1].name, "quotient");
+#else
+  EXPECT_EQ(stats.refinementRounds, 0u);
+#endif
+}
+
+TEST(STATS, IncludedIn){
+  fa::Automaton lhs;
+  EXPECT_TRUE(lhs.addSymbol('a'));
+  EXPECT_TRUE(lhs.addState(0));
+  EXPECT_TRUE(lhs.addState(1));
+  lhs.setStateInitial(0);
+  lhs.setStateFinal(1);
+  EXPECT_TRUE(lhs.addTransition(0, 'a', 1));
+
+  fa::Automaton rhs;
+  EXPECT_TRUE(rhs.addSymbol('a'));
+  EXPECT_TRUE(rhs.addState(0));
+  rhs.setStateInitial(0);
+  rhs.setStateFinal(0);
+  EXPECT_TRUE(rhs.addTransition(0, 'a', 0));
+
+  fa::Stats stats;
+  EXPECT_TRUE(lhs.isIncludedIn(rhs, stats));
+  EXPECT_FALSE(rhs.isIncludedIn(lhs, stats));
+#ifdef FA_ENABLE_STATS
+  /* the counters of the two calls are accumulated */
+  EXPECT_GT(stats.productPairs, 0u);
+  EXPECT_EQ(stats.phases.back().name, "pairs");
+#else
+  EXPECT_EQ(stats.productPairs, 0u);
+#endif
+}
+
+/*
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Those tests exist in order to test the operations giving up over their budget *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+TEST(BUDGET, DeterministicMaxStates){
+  fa::Automaton fa = createSuffixExample(7);
+
+  fa::Budget small;
+  small.maxStates = 50;
+  EXPECT_FALSE(fa::Automaton::createDeterministic(fa, small).has_value());
+  EXPECT_FALSE(fa::Automaton::createDeterministic(fa, small, 4).has_value());
+
+  fa::Budget large;
+  large.maxStates = 128;
+  large.maxTransitions = 256;
+  std::optional<fa::Automaton> deterministic = fa::Automaton::createDeterministic(fa, large);
+  ASSERT_TRUE(deterministic.has_value());
+  EXPECT_EQ(deterministic->countStates(), 128u);
+  EXPECT_TRUE(deterministic->match("abbbbbb"));
+}
+
+TEST(BUDGET, DeterministicMaxTransitions){
+  fa::Automaton fa = createSuffixExample(7);
+
+  fa::Budget budget;
+  budget.maxTransitions = 100;
+  EXPECT_FALSE(fa::Automaton::createDeterministic(fa, budget).has_value());
+}
+
+TEST(BUDGET, Cancelled){
+  fa::Automaton fa = createSuffixExample(7);
+
+  std::atomic<bool> cancelled(true);
+  fa::Budget budget;
+  budget.cancelled = &cancelled;
+  EXPECT_FALSE(fa::Automaton::createDeterministic(fa, budget).has_value());
+  EXPECT_FALSE(fa::Automaton::createComplement(fa, budget).has_value());
+  EXPECT_FALSE(fa::Automaton::createMinimalBrzozowski(fa, budget).has_value());
+  EXPECT_FALSE(fa.isIncludedIn(fa, budget).has_value());
+
+  cancelled = false;
+  EXPECT_TRUE(fa::Automaton::createDeterministic(fa, budget).has_value());
+}
+
+TEST(BUDGET, Deadline){
+  fa::Automaton fa = createSuffixExample(7);
+
+  fa::Budget budget;
+  budget.deadline = std::chrono::steady_clock::now() - std::chrono::seconds(1);
+  EXPECT_FALSE(fa::Automaton::createMinimalBrzozowski(fa, budget).has_value());
+
+  budget.deadline = std::chrono::steady_clock::now() + std::chrono::hours(1);
+  std::optional<fa::Automaton> minimal = fa::Automaton::createMinimalBrzozowski(fa, budget);
+  ASSERT_TRUE(minimal.has_value());
+  EXPECT_EQ(minimal->countStates(), 128u);
+}
+
+TEST(BUDGET, IncludedIn){
+  fa::Automaton fa = createSuffixExample(7);
+
+  fa::Automaton all;
+  EXPECT_TRUE(all.addSymbol('a'));
+  EXPECT_TRUE(all.addSymbol('b'));
+  EXPECT_TRUE(all.addState(0));
+  all.setStateInitial(0);
+  all.setStateFinal(0);
+  EXPECT_TRUE(all.addTransition(0, 'a', 0));
+  EXPECT_TRUE(all.addTransition(0, 'b', 0));
+
+  fa::Budget budget;
+  budget.maxStates = 50;
+  EXPECT_EQ(fa.isIncludedIn(all, budget), std::optional<bool>(true));
+  /* the complement of fa needs 128 states */
+  EXPECT_FALSE(all.isIncludedIn(fa, budget).has_value());
+  budget.maxStates = 1000;
+  EXPECT_EQ(all.isIncludedIn(fa, budget), std::optional<bool>(false));
+}
+
+/*
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Those tests exist in order to test the memory given to the temporary structures *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+class CountingResource : public std::pmr::memory_resource{
+public:
+  std::size_t allocations = 0;
+  std::size_t deallocations = 0;
+
+private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override{
+    allocations++;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override{
+    deallocations++;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override{
+    return this == &other;
+  }
+};
+
+TEST(RESOURCE, Deterministic){
+  fa::Automaton fa = createSuffixExample(7);
+
+  CountingResource resource;
+  fa::Automaton deterministic = fa::Automaton::createDeterministic(fa, 1, &resource);
+  fa::Automaton reference = fa::Automaton::createDeterministic(fa);
+  EXPECT_EQ(deterministic.countStates(), 128u);
+  EXPECT_EQ(deterministic.countTransitions(), reference.countTransitions());
+
+  /* the temporary structures are given back at the end of the call */
+  EXPECT_GT(resource.allocations, 0u);
+  EXPECT_EQ(resource.allocations, resource.deallocations);
+
+  fa::Automaton parallel = fa::Automaton::createDeterministic(fa, 4, &resource);
+  EXPECT_EQ(parallel.countStates(), 128u);
+  EXPECT_EQ(resource.allocations, resource.deallocations);
+}
+
+TEST(RESOURCE, MinimalMooreReusedPool){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  for(int i = 0; i < 6; i++){
+    EXPECT_TRUE(fa.addState(i));
+  }
+  for(int i = 0; i < 6; i++){
+    EXPECT_TRUE(fa.addTransition(i, 'a', (i + 1) % 6));
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(0);
+  fa.setStateFinal(3);
+
+  /* the memory of a call is reused by the next one */
+  CountingResource upstream;
+  std::pmr::unsynchronized_pool_resource pool(&upstream);
+  fa::Automaton minimal = fa::Automaton::createMinimalMoore(fa, 1, &pool);
+  EXPECT_EQ(minimal.countStates(), 3u);
+  std::size_t allocations = upstream.allocations;
+  EXPECT_GT(allocations, 0u);
+  for(int i = 0; i < 10; i++){
+    EXPECT_EQ(fa::Automaton::createMinimalMoore(fa, 1, &pool).countStates(), 3u);
+  }
+  EXPECT_EQ(upstream.allocations, allocations);
+}
+
+/*
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Those tests exist in order to verify the transformations made in place *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+TEST(INPLACE, Complete){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  EXPECT_TRUE(fa.addState(0));
+  EXPECT_TRUE(fa.addState(1));
+  fa.setStateInitial(0);
+  fa.setStateFinal(1);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 1));
+
+  fa.complete();
+  EXPECT_TRUE(fa.isComplete());
+  EXPECT_EQ(fa.countStates(), 3u);
+  EXPECT_TRUE(fa.match("a"));
+  EXPECT_FALSE(fa.match("ab"));
+
+  fa.complete();
+  EXPECT_EQ(fa.countStates(), 3u);
+}
+
+TEST(INPLACE, Complement){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addState(0));
+  EXPECT_TRUE(fa.addState(1));
+  fa.setStateInitial(0);
+  fa.setStateFinal(1);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 0));
+  EXPECT_TRUE(fa.addTransition(0, 'a', 1));
+
+  fa.complement();
+  EXPECT_TRUE(fa.isDeterministic());
+  EXPECT_TRUE(fa.isComplete());
+  EXPECT_TRUE(fa.match(""));
+  EXPECT_FALSE(fa.match("a"));
+  EXPECT_FALSE(fa.match("aaa"));
+
+  fa::Automaton twice = fa::Automaton::createComplement(std::move(fa));
+  EXPECT_FALSE(twice.match(""));
+  EXPECT_TRUE(twice.match("aaa"));
+}
+
+TEST(INPLACE, Mirror){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  for(int i = 0; i < 4; i++){
+    EXPECT_TRUE(fa.addState(i));
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(3);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 1));
+  EXPECT_TRUE(fa.addTransition(1, 'b', 3));
+  EXPECT_TRUE(fa.addTransition(2, 'a', 3));
+  EXPECT_TRUE(fa.removeState(2));
+
+  fa.mirror();
+  EXPECT_EQ(fa.countStates(), 3u);
+  EXPECT_EQ(fa.countTransitions(), 2u);
+  EXPECT_TRUE(fa.isStateInitial(3));
+  EXPECT_TRUE(fa.isStateFinal(0));
+  EXPECT_TRUE(fa.hasTransition(3, 'b', 1));
+  EXPECT_TRUE(fa.match("ba"));
+  EXPECT_FALSE(fa.match("ab"));
+
+  fa::Automaton back = fa::Automaton::createMirror(std::move(fa));
+  EXPECT_TRUE(back.match("ab"));
+  EXPECT_FALSE(back.match("ba"));
+}
+
+TEST(INPLACE, RemoveEpsilon){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  for(int i = 0; i < 3; i++){
+    EXPECT_TRUE(fa.addState(i));
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(2);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 0));
+  EXPECT_TRUE(fa.addTransition(0, fa::Epsilon, 1));
+  EXPECT_TRUE(fa.addTransition(1, 'b', 1));
+  EXPECT_TRUE(fa.addTransition(1, fa::Epsilon, 2));
+
+  fa::Automaton copy = fa;
+  fa.removeEpsilon();
+  EXPECT_FALSE(fa.hasEpsilonTransition());
+  EXPECT_TRUE(fa.isStateFinal(0));
+  EXPECT_TRUE(fa.match(""));
+  EXPECT_TRUE(fa.match("aabb"));
+  EXPECT_FALSE(fa.match("ba"));
+
+  /* the copy keeps its epsilon transitions */
+  EXPECT_TRUE(copy.hasEpsilonTransition());
+  EXPECT_FALSE(copy.isStateFinal(0));
+}
+
+TEST(INPLACE, Deterministic){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addState(0));
+  EXPECT_TRUE(fa.addState(1));
+  fa.setStateInitial(0);
+  fa.setStateFinal(1);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 1));
+
+  fa::Automaton deterministic = fa::Automaton::createDeterministic(std::move(fa));
+  EXPECT_TRUE(deterministic.isDeterministic());
+  EXPECT_EQ(deterministic.countStates(), 2u);
+  EXPECT_TRUE(deterministic.match("a"));
+}
+
+/*
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Those tests exist in order to verify the predecessors of the states *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+TEST(PREDECESSORS, Letters){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  for(int i = 1; i <= 3; i++){
+    EXPECT_TRUE(fa.addState(i));
+  }
+  EXPECT_TRUE(fa.addTransition(1, 'a', 3));
+  EXPECT_TRUE(fa.addTransition(2, 'a', 3));
+  EXPECT_TRUE(fa.addTransition(3, 'a', 3));
+  EXPECT_TRUE(fa.addTransition(1, 'b', 3));
+  EXPECT_TRUE(fa.addTransition(3, 'b', 1));
+
+  EXPECT_EQ(fa.predecessors(3, 'a'), fa::StateSet({1, 2, 3}));
+  EXPECT_EQ(fa.predecessors(3, 'b'), fa::StateSet({1}));
+  EXPECT_EQ(fa.predecessors(1, 'b'), fa::StateSet({3}));
+  EXPECT_TRUE(fa.predecessors(1, 'a').empty());
+  EXPECT_TRUE(fa.predecessors(2, 'a').empty());
+  EXPECT_TRUE(fa.predecessors(4, 'a').empty());
+}
+
+TEST(PREDECESSORS, UpdatedAfterChange){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addState(0));
+  EXPECT_TRUE(fa.addState(1));
+  EXPECT_TRUE(fa.addTransition(0, 'a', 1));
+  EXPECT_EQ(fa.predecessors(1, 'a'), fa::StateSet({0}));
+
+  fa::Automaton copy = fa;
+  EXPECT_TRUE(fa.addState(2));
+  EXPECT_TRUE(fa.addTransition(2, 'a', 1));
+  EXPECT_EQ(fa.predecessors(1, 'a'), fa::StateSet({0, 2}));
+  EXPECT_EQ(copy.predecessors(1, 'a'), fa::StateSet({0}));
+
+  EXPECT_TRUE(fa.removeState(0));
+  fa.compact();
+  EXPECT_EQ(fa.predecessors(1, 'a'), fa::StateSet({2}));
+
+  fa.mirror();
+  EXPECT_TRUE(fa.predecessors(1, 'a').empty());
+  EXPECT_EQ(fa.predecessors(2, 'a'), fa::StateSet({1}));
+}
+
+TEST(PREDECESSORS, NonCoAccessibleChain){
+  /* a long chain, the co-accessible states are found in linear time */
+  const int n = 100000;
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  for(int i = 0; i <= n; i++){
+    fa.addState(i);
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(n / 2);
+  for(int i = 0; i < n; i++){
+    fa.addTransition(i, 'a', i + 1);
+  }
+
+  fa.removeNonCoAccessibleStates();
+  EXPECT_EQ(fa.countStates(), std::size_t(n / 2 + 1));
+  EXPECT_TRUE(fa.match(std::string(n / 2, 'a')));
+}
+
+/*
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Those tests exist in order to verify that copies do not share changes *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+TEST(COPY, ChangeCopy){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addState(0));
+  EXPECT_TRUE(fa.addState(1));
+  fa.setStateInitial(0);
+  fa.setStateFinal(1);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 1));
+
+  fa::Automaton copy = fa;
+  EXPECT_TRUE(copy.addState(2));
+  EXPECT_TRUE(copy.addTransition(1, 'a', 2));
+  EXPECT_TRUE(copy.removeTransition(0, 'a', 1));
+  EXPECT_TRUE(copy.removeState(0));
+  copy.compact();
+
+  EXPECT_EQ(fa.countStates(), 2u);
+  EXPECT_EQ(fa.countTransitions(), 1u);
+  EXPECT_TRUE(fa.hasState(0));
+  EXPECT_FALSE(fa.hasState(2));
+  EXPECT_TRUE(fa.hasTransition(0, 'a', 1));
+  EXPECT_TRUE(fa.match("a"));
+
+  EXPECT_EQ(copy.countStates(), 2u);
+  EXPECT_EQ(copy.countTransitions(), 1u);
+  EXPECT_TRUE(copy.hasTransition(1, 'a', 2));
+}
+
+TEST(COPY, ChangeOriginal){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  EXPECT_TRUE(fa.addState(0));
+  EXPECT_TRUE(fa.addState(1));
+  EXPECT_TRUE(fa.addTransition(0, 'a', 1));
+  EXPECT_TRUE(fa.addTransition(0, 'b', 1));
+
+  fa::Automaton copy = fa;
+  EXPECT_TRUE(fa.removeSymbol('b'));
+  EXPECT_TRUE(fa.removeState(1));
+
+  EXPECT_TRUE(copy.hasState(1));
+  EXPECT_TRUE(copy.hasTransition(0, 'b', 1));
+  EXPECT_EQ(copy.countTransitions(), 2u);
+}
+
+TEST(COPY, Complement){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addState(0));
+  EXPECT_TRUE(fa.addState(1));
+  fa.setStateInitial(0);
+  fa.setStateFinal(1);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 1));
+  EXPECT_TRUE(fa.addTransition(1, 'a', 0));
+
+  /* the automaton is complete, the complement keeps its states and transitions */
+  fa::Automaton complement = fa::Automaton::createComplement(fa);
+  EXPECT_TRUE(complement.match("aa"));
+  EXPECT_FALSE(complement.match("a"));
+  EXPECT_TRUE(fa.match("a"));
+  EXPECT_FALSE(fa.match("aa"));
+
+  EXPECT_TRUE(complement.removeTransition(1, 'a', 0));
+  EXPECT_TRUE(fa.hasTransition(1, 'a', 0));
+  EXPECT_TRUE(fa.match("aaa"));
+}
+
+TEST(COPY, MovedFrom){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addState(0));
+
+  fa::Automaton other = std::move(fa);
+  EXPECT_TRUE(other.isValid());
+
+  /* a moved-from automaton can be assigned and filled again */
+  fa = fa::Automaton();
+  EXPECT_FALSE(fa.isValid());
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addState(0));
+  EXPECT_TRUE(fa.addTransition(0, 'a', 0));
+  EXPECT_EQ(fa.countTransitions(), 1u);
+  EXPECT_EQ(other.countTransitions(), 0u);
+}
+
+/*
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Those tests exist in order to verify the automata built at compile time *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+static constexpr fa::StaticDescription<3, 4> EvenAs = {
+  0,
+  {true, false, false},
+  {{{0, 'a', 1}, {1, 'a', 0}, {0, 'b', 0}, {1, 'b', 2}}}
+};
+
+static constexpr fa::StaticDescription<3, 4> SingleA = {
+  0,
+  {false, true, false},
+  {{{0, 'a', 1}, {0, 'b', 2}, {2, 'a', 2}, {2, 'b', 2}}}
+};
+
+static constexpr char Identifier[] = "[a-z_][a-z0-9_]*";
+static constexpr char Token[] = "[a-z]+(-[a-z]+)*";
+static constexpr char Number[] = "-?\\d+(\\.\\d+)?";
+static constexpr char BlowUp[] = "(a|b)*a(a|b)(a|b)";
+
+TEST(STATIC, Description){
+  constexpr auto automaton = fa::createStaticAutomaton<EvenAs>();
+  static_assert(automaton.countStates() == 2, "the state 2 is dead and merges with the sink");
+  static_assert(automaton.countClasses() == 3, "'a', 'b' and the other letters");
+  static_assert(automaton.match(""), "no 'a'");
+  static_assert(automaton.match("aab"), "two 'a'");
+  static_assert(!automaton.match("a"), "one 'a'");
+  static_assert(!automaton.match("ab"), "the state 2 is not final");
+  static_assert(!automaton.match("aac"), "'c' has no transition");
+
+  EXPECT_EQ(automaton.getInitialState(), 0);
+  EXPECT_TRUE(automaton.isStateFinal(0));
+  EXPECT_EQ(automaton.getTarget(0, 'a'), 1);
+  EXPECT_EQ(automaton.getTarget(1, 'b'), -1);
+  EXPECT_EQ(automaton.getTarget(0, 'c'), -1);
+  EXPECT_TRUE(automaton.match(std::string(10, 'a')));
+  EXPECT_FALSE(automaton.match(std::string(11, 'a')));
+}
+
+TEST(STATIC, DescriptionTrap){
+  constexpr auto automaton = fa::createStaticAutomaton<SingleA>();
+  static_assert(automaton.countStates() == 2, "the trap state 2 merges with the sink");
+  static_assert(automaton.match("a"), "one 'a'");
+  static_assert(!automaton.match("b"), "the trap");
+  static_assert(!automaton.match("ba"), "the trap");
+
+  EXPECT_EQ(automaton.getTarget(0, 'b'), -1);
+}
+
+TEST(STATIC, Regex){
+  constexpr auto identifier = fa::createStaticRegex<Identifier>();
+  static_assert(identifier.match("_x1"), "an identifier");
+  static_assert(!identifier.match("1x"), "a digit first");
+  static_assert(!identifier.match(""), "empty");
+
+  constexpr auto token = fa::createStaticRegex<Token>();
+  static_assert(token.match("content-type"), "two words");
+  static_assert(!token.match("content-"), "a trailing '-'");
+  static_assert(!token.match("-type"), "a leading '-'");
+
+  constexpr auto number = fa::createStaticRegex<Number>();
+  static_assert(number.match("-12.5"), "a negative decimal");
+  static_assert(number.match("7"), "a digit");
+  static_assert(!number.match("1."), "no decimal");
+  static_assert(!number.match("--1"), "two signs");
+
+  EXPECT_TRUE(token.match(std::string("keep-alive")));
+  EXPECT_FALSE(token.match(std::string("Keep-Alive")));
+}
+
+TEST(STATIC, RegexSameAsAutomaton){
+  constexpr auto automaton = fa::createStaticRegex<BlowUp>();
+  static_assert(automaton.countStates() == 8, "the minimal automaton of (a|b)*a(a|b)^2 has 8 states");
+
+  /* the runtime NFA of the same language */
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  for(int i = 0; i < 4; i++){
+    EXPECT_TRUE(fa.addState(i));
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(3);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 0));
+  EXPECT_TRUE(fa.addTransition(0, 'b', 0));
+  EXPECT_TRUE(fa.addTransition(0, 'a', 1));
+  for(int i = 1; i < 3; i++){
+    EXPECT_TRUE(fa.addTransition(i, 'a', i + 1));
+    EXPECT_TRUE(fa.addTransition(i, 'b', i + 1));
+  }
+
+  for(int length = 0; length <= 8; length++){
+    for(int bits = 0; bits < (1 << length); bits++){
+      std::string word;
+      for(int i = 0; i < length; i++){
+        word += (bits >> i & 1) ? 'b' : 'a';
+      }
+      EXPECT_EQ(automaton.match(word), fa.match(word)) << word;
+    }
+  }
+}
+
+/*
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Those tests exist in order to verify the source generated for automata *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+ * The DFA of a(b)*, completed by the non-final sink 3
+ */
+static fa::Automaton createGeneratedExample(){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  EXPECT_TRUE(fa.addSymbol('\''));
+  for(int i = 1; i <= 3; i++){
+    EXPECT_TRUE(fa.addState(i));
+  }
+  fa.setStateInitial(1);
+  fa.setStateFinal(2);
+  EXPECT_TRUE(fa.addTransition(1, 'a', 2));
+  EXPECT_TRUE(fa.addTransition(1, 'b', 3));
+  EXPECT_TRUE(fa.addTransition(1, '\'', 3));
+  EXPECT_TRUE(fa.addTransition(2, 'b', 2));
+  EXPECT_TRUE(fa.addTransition(2, '\'', 2));
+  EXPECT_TRUE(fa.addTransition(2, 'a', 3));
+  for(char letter : {'a', 'b', '\''}){
+    EXPECT_TRUE(fa.addTransition(3, letter, 3));
+  }
+  return fa;
+}
+
+TEST(GENERATE, Goto){
+  std::ostringstream os;
+  createGeneratedExample().generateSource(os, "matchExample");
+  std::string source = os.str();
+  EXPECT_NE(source.find("bool matchExample(std::string_view word){"), std::string::npos);
+  EXPECT_NE(source.find("s0:  // state 1"), std::string::npos);
+  EXPECT_NE(source.find("s1:  // state 2"), std::string::npos);
+  EXPECT_NE(source.find("goto s1;"), std::string::npos);
+  EXPECT_NE(source.find("case '\\'':"), std::string::npos);
+
+  /* the sink is left out */
+  EXPECT_EQ(source.find("state 3"), std::string::npos);
+  EXPECT_EQ(source.find("goto s2;"), std::string::npos);
+}
+
+TEST(GENERATE, Switch){
+  std::ostringstream os;
+  createGeneratedExample().generateSource(os, "matchExample", fa::SourceStyle::Switch);
+  std::string source = os.str();
+  EXPECT_NE(source.find("bool matchExample(std::string_view word){"), std::string::npos);
+  EXPECT_NE(source.find("case 1:  // state 2"), std::string::npos);
+  EXPECT_NE(source.find("state = 1; break;"), std::string::npos);
+  EXPECT_EQ(source.find("state 3"), std::string::npos);
+}
+
+TEST(GENERATE, EmptyLanguage){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addState(0));
+  fa.setStateInitial(0);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 0));
+
+  std::ostringstream os;
+  fa.generateSource(os, "matchNothing");
+  std::string source = os.str();
+  EXPECT_NE(source.find("return false;"), std::string::npos);
+  EXPECT_EQ(source.find("goto"), std::string::npos);
+}
+
+/*
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Those tests exist in order to verify the equivalence of the languages *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+TEST(EQUIVALENT, SameAsMinimal){
+  fa::Automaton fa = createSuffixExample(6);
+  fa::Automaton minimal = fa::Automaton::createMinimalMoore(fa);
+
+  std::string word = "unchanged";
+  EXPECT_TRUE(fa.isEquivalentTo(minimal, word));
+  EXPECT_EQ(word, "unchanged");
+  EXPECT_TRUE(minimal.isEquivalentTo(fa));
+  EXPECT_TRUE(fa.isEquivalentTo(fa::Automaton::createMinimalBrzozowski(fa)));
+  EXPECT_TRUE(fa.isEquivalentTo(fa));
+}
+
+TEST(EQUIVALENT, DistinguishingWord){
+  fa::Automaton lhs = createSuffixExample(3);
+  fa::Automaton rhs = createSuffixExample(4);
+
+  std::string word;
+  EXPECT_FALSE(lhs.isEquivalentTo(rhs, word));
+  EXPECT_NE(lhs.match(word), rhs.match(word)) << word;
+  EXPECT_EQ(word.size(), 3u);
+
+  word.clear();
+  EXPECT_FALSE(rhs.isEquivalentTo(fa::Automaton::createComplement(rhs), word));
+  EXPECT_EQ(word, "");
+}
+
+TEST(EQUIVALENT, DifferentAlphabets){
+  fa::Automaton lhs;
+  EXPECT_TRUE(lhs.addSymbol('a'));
+  EXPECT_TRUE(lhs.addState(0));
+  lhs.setStateInitial(0);
+  lhs.setStateFinal(0);
+  EXPECT_TRUE(lhs.addTransition(0, 'a', 0));
+
+  /* the same language a*, the letter b leading nowhere */
+  fa::Automaton rhs = lhs;
+  EXPECT_TRUE(rhs.addSymbol('b'));
+  EXPECT_TRUE(lhs.isEquivalentTo(rhs));
+  EXPECT_TRUE(rhs.isEquivalentTo(lhs));
+
+  EXPECT_TRUE(rhs.addState(1));
+  rhs.setStateFinal(1);
+  EXPECT_TRUE(rhs.addTransition(0, 'b', 1));
+  std::string word;
+  EXPECT_FALSE(lhs.isEquivalentTo(rhs, word));
+  EXPECT_EQ(word, "b");
+}
+
+TEST(EQUIVALENT, Epsilon){
+  /* a*b* with an epsilon transition between the two loops */
+  fa::Automaton lhs;
+  EXPECT_TRUE(lhs.addSymbol('a'));
+  EXPECT_TRUE(lhs.addSymbol('b'));
+  EXPECT_TRUE(lhs.addState(0));
+  EXPECT_TRUE(lhs.addState(1));
+  lhs.setStateInitial(0);
+  lhs.setStateFinal(1);
+  EXPECT_TRUE(lhs.addTransition(0, 'a', 0));
+  EXPECT_TRUE(lhs.addTransition(0, fa::Epsilon, 1));
+  EXPECT_TRUE(lhs.addTransition(1, 'b', 1));
+
+  fa::Automaton rhs = fa::Automaton::createWithoutEpsilon(lhs);
+  EXPECT_TRUE(lhs.isEquivalentTo(rhs));
+  EXPECT_TRUE(rhs.isEquivalentTo(lhs));
+
+  EXPECT_TRUE(rhs.addTransition(1, 'a', 0));
+  std::string word;
+  EXPECT_FALSE(lhs.isEquivalentTo(rhs, word));
+  EXPECT_NE(lhs.match(word), rhs.match(word)) << word;
+  EXPECT_TRUE(lhs.hasEpsilonTransition());
+}
+
+/*
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Those tests exist in order to verify the universality check *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+TEST(UNIVERSAL, PrunedSubsets){
+  /* every subset includes the final state 0, so the suffix part is never explored */
+  fa::Automaton fa = createSuffixExample(40);
+  fa.setStateFinal(0);
+  EXPECT_TRUE(fa.isUniversal());
+
+  std::string word = "unchanged";
+  EXPECT_TRUE(fa.isUniversal(word));
+  EXPECT_EQ(word, "unchanged");
+}
+
+TEST(UNIVERSAL, ShortestRejectedWord){
+  /* the words without bb, state 2 being a non-final sink */
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  for(int i = 0; i < 3; i++){
+    EXPECT_TRUE(fa.addState(i));
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(0);
+  fa.setStateFinal(1);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 0));
+  EXPECT_TRUE(fa.addTransition(0, 'b', 1));
+  EXPECT_TRUE(fa.addTransition(1, 'a', 0));
+  EXPECT_TRUE(fa.addTransition(1, 'b', 2));
+  EXPECT_TRUE(fa.addTransition(2, 'a', 2));
+  EXPECT_TRUE(fa.addTransition(2, 'b', 2));
+
+  std::string word;
+  EXPECT_FALSE(fa.isUniversal(word));
+  EXPECT_EQ(word, "bb");
+
+  EXPECT_FALSE(createSuffixExample(3).isUniversal(word));
+  EXPECT_EQ(word, "");
+}
+
+TEST(UNIVERSAL, MissingLetter){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  EXPECT_TRUE(fa.addState(0));
+  fa.setStateInitial(0);
+  fa.setStateFinal(0);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 0));
+
+  std::string word;
+  EXPECT_FALSE(fa.isUniversal(word));
+  EXPECT_EQ(word, "b");
+
+  EXPECT_TRUE(fa.addTransition(0, 'b', 0));
+  EXPECT_TRUE(fa.isUniversal());
+}
+
+TEST(UNIVERSAL, Epsilon){
+  /* a*b*, then (a|b)* once b leads back to the a loop */
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  EXPECT_TRUE(fa.addState(0));
+  EXPECT_TRUE(fa.addState(1));
+  fa.setStateInitial(0);
+  fa.setStateFinal(1);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 0));
+  EXPECT_TRUE(fa.addTransition(0, fa::Epsilon, 1));
+  EXPECT_TRUE(fa.addTransition(1, 'b', 1));
+
+  std::string word;
+  EXPECT_FALSE(fa.isUniversal(word));
+  EXPECT_EQ(word, "ba");
+
+  EXPECT_TRUE(fa.addTransition(1, 'b', 0));
+  EXPECT_TRUE(fa.isUniversal());
+}
+
+/*
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Those tests exist in order to verify the reduction by simulation *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+TEST(SIMULATION, MergeEquivalentStates){
+  /* ab, with two copies of the path */
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  for(int i = 0; i < 5; i++){
+    EXPECT_TRUE(fa.addState(i));
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(3);
+  fa.setStateFinal(4);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 1));
+  EXPECT_TRUE(fa.addTransition(0, 'a', 2));
+  EXPECT_TRUE(fa.addTransition(1, 'b', 3));
+  EXPECT_TRUE(fa.addTransition(2, 'b', 4));
+
+  fa::Automaton reduced = fa::Automaton::createReducedBySimulation(fa);
+  EXPECT_EQ(reduced.countStates(), 3u);
+  EXPECT_EQ(reduced.countTransitions(), 2u);
+  EXPECT_TRUE(reduced.hasTransition(0, 'a', 1));
+  EXPECT_TRUE(reduced.hasTransition(1, 'b', 3));
+  EXPECT_TRUE(reduced.isEquivalentTo(fa));
+
+  /* the input is left untouched */
+  EXPECT_EQ(fa.countStates(), 5u);
+}
+
+TEST(SIMULATION, PruneSimulatedTarget){
+  /* a(b|c) next to ab: the state 1 is simulated by the state 2 */
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  EXPECT_TRUE(fa.addSymbol('c'));
+  for(int i = 0; i < 4; i++){
+    EXPECT_TRUE(fa.addState(i));
+  }
+  fa.setStateInitial(0);
+  fa.setStateInitial(1);
+  fa.setStateFinal(3);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 1));
+  EXPECT_TRUE(fa.addTransition(0, 'a', 2));
+  EXPECT_TRUE(fa.addTransition(1, 'b', 3));
+  EXPECT_TRUE(fa.addTransition(2, 'b', 3));
+  EXPECT_TRUE(fa.addTransition(2, 'c', 3));
+
+  fa::Automaton reduced = fa::Automaton::createReducedBySimulation(fa);
+  EXPECT_FALSE(reduced.hasTransition(0, 'a', 1));
+  EXPECT_TRUE(reduced.hasTransition(0, 'a', 2));
+  EXPECT_TRUE(reduced.isStateInitial(1));
+  EXPECT_EQ(reduced.countStates(), 4u);
+  EXPECT_TRUE(reduced.isEquivalentTo(fa));
+}
+
+TEST(SIMULATION, EmptyLanguage){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addState(0));
+  EXPECT_TRUE(fa.addState(1));
+  fa.setStateInitial(0);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 1));
+
+  fa::Automaton reduced = fa::Automaton::createReducedBySimulation(fa, true);
+  EXPECT_EQ(reduced.countStates(), 1u);
+  EXPECT_EQ(reduced.countTransitions(), 0u);
+  EXPECT_EQ(reduced.countSymbols(), 1u);
+  EXPECT_TRUE(reduced.hasSymbol('a'));
+  EXPECT_FALSE(reduced.hasSymbol('q'));
+  EXPECT_TRUE(reduced.isLanguageEmpty());
+  EXPECT_TRUE(reduced.isValid());
+}
+
+TEST(SIMULATION, StaysNonDeterministic){
+  fa::Automaton fa = createSuffixExample(8);
+  fa::Automaton reduced = fa::Automaton::createReducedBySimulation(fa, true);
+  EXPECT_EQ(reduced.countStates(), 9u);
+  EXPECT_FALSE(reduced.isDeterministic());
+  EXPECT_TRUE(reduced.isEquivalentTo(fa));
+}
+
+TEST(SIMULATION, Backward){
+  /* ab|ac, the states reached by a only merged by the backward simulation */
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  EXPECT_TRUE(fa.addSymbol('c'));
+  for(int i = 0; i < 5; i++){
+    EXPECT_TRUE(fa.addState(i));
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(3);
+  fa.setStateFinal(4);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 1));
+  EXPECT_TRUE(fa.addTransition(0, 'a', 2));
+  EXPECT_TRUE(fa.addTransition(1, 'b', 3));
+  EXPECT_TRUE(fa.addTransition(2, 'c', 4));
+
+  fa::Automaton forward = fa::Automaton::createReducedBySimulation(fa);
+  EXPECT_EQ(forward.countStates(), 4u);
+  EXPECT_TRUE(forward.isEquivalentTo(fa));
+
+  fa::Automaton both = fa::Automaton::createReducedBySimulation(fa, true);
+  EXPECT_EQ(both.countStates(), 3u);
+  EXPECT_TRUE(both.isDeterministic());
+  EXPECT_TRUE(both.isEquivalentTo(fa));
+}
+
+/*
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Those tests exist in order to verify the quotient by bisimulation *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+TEST(BISIMULATION, MergeBisimilarStates){
+  /* ab|ab, with a loop on b kept by both copies */
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  for(int i = 0; i < 5; i++){
+    EXPECT_TRUE(fa.addState(i));
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(3);
+  fa.setStateFinal(4);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 1));
+  EXPECT_TRUE(fa.addTransition(0, 'a', 2));
+  EXPECT_TRUE(fa.addTransition(1, 'b', 3));
+  EXPECT_TRUE(fa.addTransition(2, 'b', 4));
+  EXPECT_TRUE(fa.addTransition(3, 'b', 3));
+  EXPECT_TRUE(fa.addTransition(4, 'b', 4));
+
+  fa::Automaton reduced = fa::Automaton::createReducedByBisimulation(fa);
+  EXPECT_EQ(reduced.countStates(), 3u);
+  EXPECT_EQ(reduced.countTransitions(), 3u);
+  EXPECT_TRUE(reduced.hasTransition(0, 'a', 1));
+  EXPECT_TRUE(reduced.hasTransition(1, 'b', 3));
+  EXPECT_TRUE(reduced.hasTransition(3, 'b', 3));
+  EXPECT_TRUE(reduced.isEquivalentTo(fa));
+}
+
+TEST(BISIMULATION, KeepSimulatedStates){
+  /* the state 1 is simulated by the state 2, but they are not bisimilar */
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  EXPECT_TRUE(fa.addSymbol('c'));
+  for(int i = 0; i < 4; i++){
+    EXPECT_TRUE(fa.addState(i));
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(3);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 1));
+  EXPECT_TRUE(fa.addTransition(0, 'a', 2));
+  EXPECT_TRUE(fa.addTransition(1, 'b', 3));
+  EXPECT_TRUE(fa.addTransition(2, 'b', 3));
+  EXPECT_TRUE(fa.addTransition(2, 'c', 3));
+
+  fa::Automaton reduced = fa::Automaton::createReducedByBisimulation(fa);
+  EXPECT_EQ(reduced.countStates(), 4u);
+  EXPECT_EQ(reduced.countTransitions(), 5u);
+}
+
+TEST(BISIMULATION, SameAsMoore){
+  /* on a complete DFA, the bisimulation is the equivalence of the languages */
+  fa::Automaton dfa = fa::Automaton::createDeterministic(createSuffixExample(4));
+  dfa.complete();
+  fa::Automaton reduced = fa::Automaton::createReducedByBisimulation(dfa);
+  EXPECT_EQ(reduced.countStates(), fa::Automaton::createMinimalMoore(dfa).countStates());
+  EXPECT_TRUE(reduced.isDeterministic());
+
+  /* the NFA is already a quotient */
+  fa::Automaton nfa = fa::Automaton::createReducedByBisimulation(createSuffixExample(4));
+  EXPECT_EQ(nfa.countStates(), 5u);
+  EXPECT_FALSE(nfa.isDeterministic());
+}
+
+TEST(BISIMULATION, Epsilon){
+  /* a* twice, one copy behind an epsilon transition */
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  for(int i = 0; i < 3; i++){
+    EXPECT_TRUE(fa.addState(i));
+    fa.setStateFinal(i);
+  }
+  fa.setStateInitial(0);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 1));
+  EXPECT_TRUE(fa.addTransition(1, 'a', 1));
+  EXPECT_TRUE(fa.addTransition(0, fa::Epsilon, 2));
+  EXPECT_TRUE(fa.addTransition(2, 'a', 2));
+
+  fa::Automaton reduced = fa::Automaton::createReducedByBisimulation(fa);
+  EXPECT_FALSE(reduced.hasEpsilonTransition());
+  EXPECT_EQ(reduced.countStates(), 1u);
+  EXPECT_TRUE(reduced.isEquivalentTo(fa));
+}
+
+/*
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Those tests exist in order to verify the shortest witness words *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+TEST(WITNESS, ShortestAcceptedWord){
+  fa::Automaton fa = createSuffixExample(3);
+  EXPECT_EQ(fa.shortestAcceptedWord(), std::optional<std::string>("aaa"));
+
+  fa.setStateFinal(0);
+  EXPECT_EQ(fa.shortestAcceptedWord(), std::optional<std::string>(""));
+
+  /* the final state is not reachable anymore */
+  fa::Automaton empty = createSuffixExample(3);
+  EXPECT_TRUE(empty.removeTransition(0, 'a', 1));
+  EXPECT_TRUE(empty.isLanguageEmpty());
+  EXPECT_EQ(empty.shortestAcceptedWord(), std::nullopt);
+}
+
+TEST(WITNESS, ShortestCommonWord){
+  /* the words ending with a(a|b)(a|b), and those of even length */
+  fa::Automaton suffix = createSuffixExample(3);
+  fa::Automaton even;
+  EXPECT_TRUE(even.addSymbol('a'));
+  EXPECT_TRUE(even.addSymbol('b'));
+  EXPECT_TRUE(even.addState(0));
+  EXPECT_TRUE(even.addState(1));
+  even.setStateInitial(0);
+  even.setStateFinal(0);
+  for(char letter : {'a', 'b'}){
+    EXPECT_TRUE(even.addTransition(0, letter, 1));
+    EXPECT_TRUE(even.addTransition(1, letter, 0));
+  }
+
+  std::optional<std::string> word = suffix.shortestCommonWord(even);
+  ASSERT_TRUE(word);
+  EXPECT_EQ(word->size(), 4u);
+  EXPECT_TRUE(suffix.match(*word));
+  EXPECT_TRUE(even.match(*word));
+
+  EXPECT_EQ(suffix.shortestCommonWord(fa::Automaton::createComplement(suffix)), std::nullopt);
+}
+
+TEST(WITNESS, ShortestDifferenceWord){
+  fa::Automaton lhs = createSuffixExample(3);
+  fa::Automaton rhs = createSuffixExample(4);
+
+  std::optional<std::string> word = lhs.shortestDifferenceWord(rhs);
+  ASSERT_TRUE(word);
+  EXPECT_EQ(*word, "aaa");
+  EXPECT_TRUE(lhs.match(*word));
+  EXPECT_FALSE(rhs.match(*word));
+
+  /* a language is included in itself and in the universal one */
+  EXPECT_EQ(lhs.shortestDifferenceWord(lhs), std::nullopt);
+  fa::Automaton all = createSuffixExample(3);
+  all.setStateFinal(0);
+  EXPECT_EQ(lhs.shortestDifferenceWord(all), std::nullopt);
+  EXPECT_EQ(all.shortestDifferenceWord(lhs), std::optional<std::string>(""));
+}
+
+/*
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Those tests exist in order to verify the counting of the words *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+TEST(COUNT, EveryWord){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  EXPECT_TRUE(fa.addState(0));
+  fa.setStateInitial(0);
+  fa.setStateFinal(0);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 0));
+  EXPECT_TRUE(fa.addTransition(0, 'b', 0));
+
+  EXPECT_EQ(fa.countWords(0), 1u);
+  EXPECT_EQ(fa.countWords(10), 1024u);
+  EXPECT_EQ(fa.countWords(63), std::uint64_t(1) << 63);
+
+  /* the count saturates */
+  EXPECT_EQ(fa.countWords(64), UINT64_MAX);
+  EXPECT_EQ(fa.countWords(1000000000000), UINT64_MAX);
+}
+
+TEST(COUNT, MinimalAndNonDeterministic){
+  /* the words ending with a(a|b)(a|b): 2^(n-1) of length n from 3 on */
+  fa::Automaton nfa = createSuffixExample(3);
+  fa::Automaton minimal = fa::Automaton::createMinimalMoore(nfa);
+  for(std::size_t length = 0; length < 20; length++){
+    std::uint64_t expected = length < 3 ? 0 : std::uint64_t(1) << (length - 1);
+    EXPECT_EQ(minimal.countWords(length), expected) << length;
+    EXPECT_EQ(nfa.countWords(length), expected) << length;
+  }
+}
+
+TEST(COUNT, LargeLength){
+  /* a* and a*b: two words of every positive length */
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  EXPECT_TRUE(fa.addState(0));
+  EXPECT_TRUE(fa.addState(1));
+  fa.setStateInitial(0);
+  fa.setStateFinal(0);
+  fa.setStateFinal(1);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 0));
+  EXPECT_TRUE(fa.addTransition(0, 'b', 1));
+
+  EXPECT_EQ(fa.countWords(0), 1u);
+  EXPECT_EQ(fa.countWords(7), 2u);
+  EXPECT_EQ(fa.countWords(1000000000000000), 2u);
+}
+
+/*
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Those tests exist in order to verify the drawing of the words *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+TEST(SAMPLER, Uniform){
+  /* a(a|b|c)(a|b|c) and bbb: 10 words, a walk choosing the letters evenly would give bbb half the time */
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  EXPECT_TRUE(fa.addSymbol('c'));
+  for(int i = 0; i < 6; i++){
+    EXPECT_TRUE(fa.addState(i));
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(3);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 1));
+  for(char letter : {'a', 'b', 'c'}){
+    EXPECT_TRUE(fa.addTransition(1, letter, 2));
+    EXPECT_TRUE(fa.addTransition(2, letter, 3));
+  }
+  EXPECT_TRUE(fa.addTransition(0, 'b', 4));
+  EXPECT_TRUE(fa.addTransition(4, 'b', 5));
+  EXPECT_TRUE(fa.addTransition(5, 'b', 3));
+
+  fa::WordSampler sampler(fa, 3);
+  EXPECT_FALSE(sampler.isEmpty());
+  std::mt19937_64 random(42);
+  std::map<std::string, int> counts;
+  for(int i = 0; i < 10000; i++){
+    std::optional<std::string> word = sampler.sample(random);
+    ASSERT_TRUE(word);
+    EXPECT_TRUE(fa.match(*word));
+    counts[*word]++;
+  }
+  EXPECT_EQ(counts.size(), 10u);
+  for(auto const &count : counts){
+    EXPECT_GT(count.second, 800) << count.first;
+    EXPECT_LT(count.second, 1200) << count.first;
+  }
+}
+
+TEST(SAMPLER, Empty){
+  /* the words ending with a(a|b)(a|b): none shorter than 3 */
+  fa::Automaton nfa = createSuffixExample(3);
+  std::mt19937_64 random(1);
+  fa::WordSampler sampler(nfa, 2);
+  EXPECT_TRUE(sampler.isEmpty());
+  EXPECT_EQ(sampler.sample(random), std::nullopt);
+  char buffer[4] = {'x', 'x', 'x', 'x'};
+  EXPECT_FALSE(sampler.sample(random, buffer, 2));
+  EXPECT_EQ(std::string(buffer, 4), "xxxx");
+
+  /* no initial state */
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addState(0));
+  fa.setStateFinal(0);
+  EXPECT_TRUE(fa::WordSampler(fa, 0).isEmpty());
+
+  /* the empty word */
+  fa.setStateInitial(0);
+  EXPECT_EQ(fa::WordSampler(fa, 0).sample(random), std::optional<std::string>(""));
+}
+
+TEST(SAMPLER, Batch){
+  /* a long length, whose counts are far beyond 64 bits, drawn from the non deterministic automaton */
+  fa::Automaton nfa = createSuffixExample(4);
+  fa::WordSampler sampler(nfa, 200);
+  EXPECT_EQ(sampler.getLength(), 200u);
+  std::mt19937_64 random(7);
+  std::vector<char> buffer(50 * 200);
+  EXPECT_TRUE(sampler.sample(random, buffer.data(), 50));
+  for(std::size_t i = 0; i < 50; i++){
+    EXPECT_TRUE(nfa.match(std::string(buffer.data() + i * 200, 200))) << i;
+  }
+}
+
+TEST(SAMPLER, FixedPrefix){
+  /* 200 times '0', then any of 64 letters: the prefix states accept one word when the last one accepts 2^60 */
+  fa::Automaton fa;
+  for(int i = 0; i < 64; i++){
+    EXPECT_TRUE(fa.addSymbol('0' + i));
+  }
+  for(int i = 0; i <= 200; i++){
+    EXPECT_TRUE(fa.addState(i));
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(200);
+  for(int i = 0; i < 200; i++){
+    EXPECT_TRUE(fa.addTransition(i, '0', i + 1));
+  }
+  for(int i = 0; i < 64; i++){
+    EXPECT_TRUE(fa.addTransition(200, '0' + i, 200));
+  }
+
+  std::mt19937_64 random(11);
+  fa::WordSampler exact(fa, 200);
+  EXPECT_EQ(fa.countWords(200), 1u);
+  EXPECT_FALSE(exact.isEmpty());
+  EXPECT_EQ(exact.sample(random), std::optional<std::string>(std::string(200, '0')));
+
+  fa::WordSampler longer(fa, 210);
+  EXPECT_EQ(fa.countWords(210), std::uint64_t(1) << 60);
+  EXPECT_FALSE(longer.isEmpty());
+  std::set<std::string> suffixes;
+  for(int i = 0; i < 100; i++){
+    std::optional<std::string> word = longer.sample(random);
+    ASSERT_TRUE(word);
+    EXPECT_TRUE(fa.match(*word));
+    suffixes.insert(word->substr(200));
+  }
+  EXPECT_EQ(suffixes.size(), 100u);
+
+  EXPECT_TRUE(fa::WordSampler(fa, 199).isEmpty());
+}
+
+/*
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+* Those tests exist in order to verify the enumeration of the words *
+* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+TEST(ENUMERATE, Shortlex){
+  /* the words ending with a(a|b), from the non deterministic automaton */
+  fa::Automaton nfa = createSuffixExample(2);
+  fa::WordEnumerator enumerator(nfa);
+  EXPECT_FALSE(enumerator.isFinite());
+
+  std::vector<std::string> expected;
+  for(std::size_t length = 2; length < 6; length++){
+    for(std::size_t bits = 0; bits < (std::size_t(1) << length); bits++){
+      std::string word(length, 'a');
+      for(std::size_t i = 0; i < length; i++){
+        if(bits & (std::size_t(1) << (length - i - 1))){
+          word[i] = 'b';
+        }
+      }
+      if(nfa.match(word)){
+        expected.push_back(word);
+      }
+    }
+  }
+  for(auto const &word : expected){
+    ASSERT_TRUE(enumerator.next());
+    EXPECT_EQ(enumerator.getWord(), word);
+  }
+  ASSERT_TRUE(enumerator.next());
+  EXPECT_EQ(enumerator.getWord(), "aaaaaa");
+}
+
+TEST(ENUMERATE, Lexicographic){
+  /* a prefix comes first, the dead state 3 is never visited */
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  EXPECT_TRUE(fa.addSymbol('c'));
+  for(int i = 0; i < 4; i++){
+    EXPECT_TRUE(fa.addState(i));
+  }
+  fa.setStateInitial(0);
+  fa.setStateFinal(1);
+  fa.setStateFinal(2);
+  EXPECT_TRUE(fa.addTransition(0, 'b', 1));
+  EXPECT_TRUE(fa.addTransition(0, 'a', 3));
+  EXPECT_TRUE(fa.addTransition(1, 'a', 2));
+  EXPECT_TRUE(fa.addTransition(1, 'c', 2));
+  EXPECT_TRUE(fa.addTransition(0, 'c', 2));
+  EXPECT_TRUE(fa.addTransition(2, 'a', 3));
+
+  fa::WordEnumerator lexicographic(fa, fa::WordOrder::Lexicographic);
+  EXPECT_TRUE(lexicographic.isFinite());
+  std::vector<std::string> words(lexicographic.begin(), lexicographic.end());
+  EXPECT_EQ(words, std::vector<std::string>({"b", "ba", "bc", "c"}));
+  EXPECT_FALSE(lexicographic.next());
+
+  std::vector<std::string> shortlex;
+  for(auto const &word : fa::WordEnumerator(fa)){
+    shortlex.push_back(word);
+  }
+  EXPECT_EQ(shortlex, std::vector<std::string>({"b", "c", "ba", "bc"}));
+}
+
+TEST(ENUMERATE, LexicographicInfinite){
+  /* a*b ordered ... < aab < ab < b has no first word */
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addSymbol('b'));
+  EXPECT_TRUE(fa.addState(0));
+  EXPECT_TRUE(fa.addState(1));
+  fa.setStateInitial(0);
+  fa.setStateFinal(1);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 0));
+  EXPECT_TRUE(fa.addTransition(0, 'b', 1));
+
+  fa::WordEnumerator lexicographic(fa, fa::WordOrder::Lexicographic);
+  EXPECT_FALSE(lexicographic.isFinite());
+  EXPECT_FALSE(lexicographic.next());
+  EXPECT_EQ(lexicographic.begin(), lexicographic.end());
+
+  fa::WordEnumerator shortlex(fa);
+  EXPECT_FALSE(shortlex.isFinite());
+  ASSERT_TRUE(shortlex.next());
+  EXPECT_EQ(shortlex.getWord(), "b");
+  ASSERT_TRUE(shortlex.next());
+  EXPECT_EQ(shortlex.getWord(), "ab");
+}
+
+TEST(ENUMERATE, Empty){
+  fa::Automaton fa;
+  EXPECT_TRUE(fa.addSymbol('a'));
+  EXPECT_TRUE(fa.addState(0));
+  EXPECT_TRUE(fa.addState(1));
+  fa.setStateInitial(0);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 0));
+  EXPECT_FALSE(fa::WordEnumerator(fa).next());
+  EXPECT_FALSE(fa::WordEnumerator(fa, fa::WordOrder::Lexicographic).next());
+
+  /* the empty word only, the loop being dead */
+  fa.setStateFinal(0);
+  EXPECT_TRUE(fa.addTransition(0, 'a', 1));
+  EXPECT_TRUE(fa.removeTransition(0, 'a', 0));
+  for(fa::WordOrder order : {fa::WordOrder::Shortlex, fa::WordOrder::Lexicographic}){
+    fa::WordEnumerator enumerator(fa, order);
+    EXPECT_TRUE(enumerator.isFinite());
+    ASSERT_TRUE(enumerator.next());
+    EXPECT_EQ(enumerator.getWord(), "");
+    EXPECT_FALSE(enumerator.next());
+    EXPECT_FALSE(enumerator.next());
+  }
+}
 
 /*
 * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *